@@ -0,0 +1,138 @@
+/*!
+ * @file index_bench.cpp
+ * @author João Guilherme Lopes Alves da Costa (joguicosta@hotmail.com)
+ * @brief Measures how fast the data file is split in lines and fields with each instruction set.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#include <algorithm> ///< To use min.
+#include <chrono> ///< To measure the time.
+#include <cstdlib> ///< To use strtoul.
+#include <fstream> ///< To read the data file.
+#include <iomanip> ///< To use setprecision.
+#include <iostream> ///< To use cout and cerr.
+#include <sstream> ///< To split the lines as the old loader did.
+#include <string> ///< To use string ans its methods.
+#include <vector> ///< To use vector and its methods.
+
+#include "struct_indexer.h"
+
+using namespace bcr;
+
+//* Size of the chunks given to the indexer (as MappedSource::WINDOW).
+static constexpr size_t CHUNK{8 << 20};
+
+/**
+ * @brief Run a function a few times and get the best speed, in GB/s.
+ */
+template <typename Func>
+static double best_speed(size_t bytes, Func func) {
+    double best{0};
+    for (int run{0}; run < 3; run++) {
+        auto start = std::chrono::steady_clock::now();
+        func();
+        std::chrono::duration<double> secs = std::chrono::steady_clock::now() - start;
+        best = std::max(best, bytes / secs.count() / 1e9);
+    }
+    return best;
+}
+
+/**
+ * @brief Split the text in lines and fields as the old loader did (getline on the line, then on each comma).
+ */
+static size_t split_getline(const std::string &text) {
+    std::istringstream in(text);
+    std::string line, field;
+    size_t n_fields{0};
+    while (std::getline(in, line)) {
+        std::istringstream ss(line);
+        while (std::getline(ss, field, ',')) {
+            n_fields++;
+        }
+    }
+    return n_fields;
+}
+
+/**
+ * @brief Index the text chunk by chunk and walk the structurals, as LineReader does.
+ * @param count_fields If the fields are counted too (otherwise only the indexing is measured).
+ */
+static size_t split_indexed(const StructIndexer &indexer, const std::string &text, bool count_fields) {
+    std::vector<uint32_t> positions;
+    size_t n_fields{0};
+    size_t field_begin{0}; ///< Where the current field begins in the text.
+    for (size_t i{0}; i < text.size(); i += CHUNK) {
+        const char *chunk = text.data() + i;
+        indexer.index(chunk, std::min(CHUNK, text.size() - i), positions);
+        if (not count_fields) {
+            n_fields += positions.size();
+            continue;
+        }
+        for (uint32_t at : positions) {
+            // A field ends at each comma, and at each newline after a non empty field (as getline does).
+            if (chunk[at] == ',' or i + at > field_begin) {
+                n_fields++;
+            }
+            field_begin = i + at + 1;
+        }
+    }
+    return n_fields;
+}
+
+int main(int argc, char *argv[]) {
+    std::string file_name = (argc > 1) ? argv[1] : "data/brands.txt";
+    size_t target_mb = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 128;
+
+    //* [1] Repeat the data file in memory until it has the wanted size.
+    std::ifstream file(file_name, std::ios::binary);
+    if (not file.is_open()) {
+        std::cerr << "Usage: " << argv[0] << " [<data_file>] [<size in MB>]\n";
+        std::cerr << ">>> ERROR! We couldn't open \"" << file_name << "\".\n";
+        return EXIT_FAILURE;
+    }
+    std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    if (content.empty()) {
+        std::cerr << ">>> ERROR! The file \"" << file_name << "\" is empty.\n";
+        return EXIT_FAILURE;
+    }
+    if (content.back() != '\n') {
+        content += '\n';
+    }
+    std::string text;
+    text.reserve(target_mb << 20);
+    while (text.size() < (target_mb << 20)) {
+        text += content;
+    }
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << ">>> " << text.size() / 1e6 << " MB of \"" << file_name << "\".\n\n";
+    std::cout << std::left << std::setw(10) << "isa" << std::setw(14) << "index GB/s"
+              << std::setw(14) << "split GB/s" << "speedup\n";
+
+    //* [2] The old way, as the reference.
+    size_t expected{0};
+    double base = best_speed(text.size(), [&]() { expected = split_getline(text); });
+    std::cout << std::setw(10) << "getline" << std::setw(14) << "-" << std::setw(14) << base << "1.00x\n";
+
+    //* [3] Each instruction set supported by the CPU.
+    for (auto isa : {StructIndexer::SCALAR, StructIndexer::SSE42, StructIndexer::AVX2}) {
+        if (not StructIndexer::supported(isa)) {
+            std::cout << std::setw(10) << StructIndexer::isa_name(isa) << "not supported by this CPU\n";
+            continue;
+        }
+        StructIndexer indexer(isa);
+        size_t n_fields{0};
+        double index = best_speed(text.size(), [&]() { split_indexed(indexer, text, false); });
+        double split = best_speed(text.size(), [&]() { n_fields = split_indexed(indexer, text, true); });
+        std::cout << std::setw(10) << StructIndexer::isa_name(isa) << std::setw(14) << index
+                  << std::setw(14) << split << split / base << "x";
+        if (n_fields != expected) {
+            std::cout << "  (WRONG: " << n_fields << " fields, expected " << expected << ")";
+        }
+        std::cout << "\n";
+    }
+    return EXIT_SUCCESS;
+}
@@ -16,15 +16,22 @@
 #include <string> ///< To use string ans its methods.
 #include <cctype> ///< To use tolower.
 #include <sstream> ///< To handling the stringstream and ostringstream.
-#include <fstream> ///< To handling files (ifstream).
-#include <set> ///< To salve all categories of the data.
-#include <map> ///< To match a category with a color.
 #include <vector> ///< To use vector and its methods.
 #include <algorithm> ///< To swap elements in sort.
 #include <thread> ///< To pause the current thread for a few ms.
+#include <chrono> ///< To measure the time spent reading the data file.
+#include <cstdlib> ///< EXIT_SUCCESS and EXIT_FAILURE.
 
 #include "../lib/text_color.h"
+#include "asciicast.h"
 #include "bar_chart.h"
+#include "color_table.h"
+#include "data_validator.h"
+#include "frame_compositor.h"
+#include "frame_layout.h"
+#include "frame_renderer.h"
+#include "input_source.h"
+#include "ranker.h"
 
 /**
  * @namespace bcr contains all the classes used in the bar chart race.
@@ -39,13 +46,43 @@ namespace bcr {
             WELCOME, //!< Welcome message.
             READING, //!< Reading the input file.
             RACING, //!< Animating the bar charts.
+            VALIDATING, //!< Checking the input file and reporting its issues.
+            PLAYING, //!< Playing a recording back.
         };
         //* Struct to store the options of the program passed by command line.
         struct RunningOpt {
             size_t fps{24}; //!< Quantity of fps per second.
             size_t n_bars{5}; //!< Number of bars in the animation.
-            std::string data_filename; //!< Name of data file.
+            std::vector<std::string> data_filenames; //!< Name of each data file (one race each).
             std::string exe_filename; //!< Name of executable file.
+            bool validate{false}; //!< Only check the data file and report its issues.
+            bool skip_bad{false}; //!< Skip the corrupt charts instead of stopping.
+            bool use_cache{true}; //!< Read and write the layout cache next to the data file.
+            ColorTable::Depth color_depth{ColorTable::AUTO}; //!< The color depth of the categories.
+            InputSource::Mode io_mode{InputSource::MMAP}; //!< How the data file is read.
+            bool headless{false}; //!< Don't wait for the user nor the fps, and report the times at the end.
+            size_t bar_len{DEFAULT_BAR_WIDTH}; //!< The length of the largest bar (one of BAR_WIDTHS).
+            bool overtakes{false}; //!< Mark the bars that went up in the ranking.
+            std::string record_filename; //!< Where the frames are recorded (asciicast), if not empty.
+            std::string play_filename; //!< The recording to play back, instead of a race, if not empty.
+        };
+        //* Struct with the data of a race (a data file) and everything needed to draw it.
+        struct Race {
+            std::string data_filename; //!< Name of data file.
+            Database data_base; //!< The data of the file that will be displayed.
+            ColorTable colors; //!< The color of each category.
+            std::string legend; //!< The color legend, ready to be displayed.
+            size_t n_skipped_blocks{0}; //!< Number of corrupt charts skipped while reading.
+            FrameLayout layout; //!< The layout of all charts, ready to be drawn.
+            std::unique_ptr<FrameRenderer> renderer; //!< Draws the frames with the chosen bar length.
+            std::string frame_text; //!< The text of the last frame drawn (its memory is reused).
+            size_t frame{0}; //!< The chart shown in the current tick.
+            bool started{false}; //!< If the shared clock reached the first chart (before it, the race waits).
+            IoStats io_stats; //!< The statistics of the reading of the data file.
+            InputSource::Compression io_compression{InputSource::NONE}; //!< The compression of the data file.
+            uint64_t load_ns{0}; //!< Time spent reading the data file (ns), 0 if it wasn't read.
+            Ranker ranker; //!< Sorts the bars of each chart, from the order of the previous one.
+            std::string error; //!< Why the race couldn't be loaded (empty if it was).
         };
 
         //== Public methods
@@ -62,47 +99,66 @@ namespace bcr {
             void welcome_message(void);
 
             /**
-             * @brief Sort a bar chart in descending order according to the value of the bars
-             * (it's used Selection sort).
-             * @param bc The bar chart that will be sorted (vector of BarItem).
-             * @return std::vector<BarChart::BarItem> The bar chart (vector of bars) in descending order.
+             * @brief Display the current bar chart of every race, in a single write.
+             */
+            void display_bc(void);
+            
+            /**
+             * @brief Read the data file of a race and store the informations.
+             * @param race The race (its data_filename is the file that will be read).
+             * @param out Where the progress messages will be printed out.
+             * @return true if the file was read.
+             * @return false otherwise (the reason is stored in the error of the race).
              */
-            std::vector<BarChart::BarItem> sort_bc(std::vector<BarChart::BarItem> bc) {
-                for (size_t i{0}; i < bc.size() - 1; i++) {
-                    auto pos_max = i;
-                    for (size_t j{i+1}; j < bc.size(); j++) {
-                        if (bc[j].value > bc[pos_max].value) {
-                            pos_max = j;
-                        }
-                    }
-                    std::swap(bc[i], bc[pos_max]);
-                }
-                return bc;
-            }
+            bool read_input_file(Race &race, std::ostream &out);
 
             /**
-             * @brief Get the axis x from a collection of bars.
-             * @param n_bars The number of bars that will be printed.
-             * @param bis The bars that compose the bar chart.
-             * @return std::ostringstream the axis x that will be displayed.
+             * @brief Get the layout of the charts of a race, from the cache file when it's up to date,
+             * or reading the data file and computing it otherwise.
+             * @param race The race.
+             * @param out Where the progress messages will be printed out.
+             * @return true if the layout is ready.
+             * @return false otherwise (the reason is stored in the error of the race).
              */
-            std::ostringstream get_axis(size_t n_bars, std::vector<BarChart::BarItem> bis) const;
-            
+            bool load_layout(Race &race, std::ostream &out);
+
             /**
-             * @brief Display the current bar chart.
+             * @brief Give a color to each category of a race, build its color legend and its renderer.
+             * @param race The race (with its layout).
+             * @param shared The categories of all races shown together (empty for a single race).
              */
-            void display_bc(void);
-            
+            void assign_colors(Race &race, const std::vector<std::string> &shared);
+
             /**
-             * @brief Read the data file and store the informations.
-             * @param file_name The name of file that will be read.
+             * @brief Get the layout of every race, each one in its own thread when there are many.
              */
-            void read_input_file(std::string file_name);
+            void load_races(void);
 
             /**
-             * @brief Prints out the summary of the data, after reading.
+             * @brief Move to the next tick of the shared timeline: the races with a chart at the earliest
+             * next time stamp move to it, and the other ones stay on their chart. The next chart of a race
+             * that didn't start is its first one, so the first tick starts only the earliest races.
+             * @return true if some race moved.
+             * @return false if every race is on its last chart.
              */
-            void summary(void);
+            bool next_tick(void);
+
+            /**
+             * @brief Check the whole data file and print out every issue found.
+             * @param file_name The name of file that will be validated.
+             */
+            void validate_file(std::string file_name);
+
+            /**
+             * @brief Play a recording back (see CastPlayer), with the timing of its frames unless headless.
+             */
+            void play_recording(void);
+
+            /**
+             * @brief Prints out the summary of the data of a race, after reading.
+             * @param race The race.
+             */
+            void summary(const Race &race);
 
             /**
              * @brief Starts the program according to the arguments passed by command line.
@@ -118,6 +174,12 @@ namespace bcr {
              */
             bool ended(void);
 
+            /**
+             * @brief Get the exit status of the program.
+             * @return int EXIT_FAILURE if a validation found issues, EXIT_SUCCESS otherwise.
+             */
+            int get_exit_status(void) const;
+
             /**
              * @brief Processes an event depending on the state of the program
              */
@@ -135,18 +197,19 @@ namespace bcr {
              */
             void render(void);
 
-            /**
-             * @brief Clean the terminal before render the next bar chart.
-             */
-            void clear_screen(void);
-
         //== Private attributes
         private:
             RunningOpt opt; ///< The options/arguments passed by command line.
             AppState app_state; ///< State of the program.
-            Database data_base; ///< The data of the file that will be displayed.
-            std::set<std::string> cat; ///< All categories of the data.
-            std::map<std::string, Color::value_t> cat_color; ///< The color of the different categories in the chart.
+            std::vector<Race> races; ///< The races shown side by side, sharing the timeline.
+            FrameCompositor compositor; ///< Puts the frames of the races in a grid.
+            std::vector<std::string_view> cells; ///< The frame of each race in the current tick.
+            std::string frame_text; ///< The text written in each tick (its memory is reused).
+            CastRecorder recorder; ///< Records the frames, with the option --record.
+            uint64_t layout_ns{0}; ///< Time spent getting the layout of the charts (ns), reading included.
+            uint64_t render_ns{0}; ///< Time spent drawing the charts (ns).
+            size_t n_rendered{0}; ///< Number of charts drawn.
+            int exit_status{EXIT_SUCCESS}; ///< The exit status of the program.
     };
 }
 
@@ -0,0 +1,134 @@
+#ifndef _ASCIICAST_H_
+#define _ASCIICAST_H_
+
+/*!
+ * @file asciicast.h
+ * @author João Guilherme Lopes Alves da Costa (joguicosta@hotmail.com)
+ * @brief Classes that record the frames of the race in an asciicast (v2) file, and play it back.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#include <cstdint> ///< To use uint64_t.
+#include <fstream> ///< To write the recording.
+#include <string> ///< To use string ans its methods.
+#include <string_view> ///< To give the frames without copying them.
+#include <utility> ///< To use pair.
+#include <vector> ///< To use vector and its methods.
+
+/**
+ * @namespace bcr contains all the classes used in the bar chart race.
+ */
+namespace bcr {
+    //* This class writes the frames of the race to an asciicast v2 file (a JSON header, then one
+    // [time, "o", data] event per line). Each frame is written as the lines that changed since the
+    // previous one, each placed with the cursor, so the file stays small and any asciicast player replays it.
+    class CastRecorder {
+        //== Public members
+        public:
+            /**
+             * @brief Create the recording file and write its header.
+             * @param file_name The name of the recording file (it must be seekable, for the header is completed at the end).
+             * @param title The title of the recording.
+             * @return true if the file was created.
+             * @return false otherwise.
+             */
+            bool open(const std::string &file_name, const std::string &title);
+
+            /**
+             * @brief Check if a recording is open.
+             * @return true if the frames are being recorded.
+             * @return false otherwise.
+             */
+            bool is_open(void) const;
+
+            /**
+             * @brief Record a frame.
+             * @param frame The text of the frame, as it would be written to the terminal (without clearing it).
+             * @param time When the frame is shown, in seconds from the first one.
+             */
+            void add_frame(std::string_view frame, double time);
+
+            /**
+             * @brief Complete the header (with the size of the terminal) and close the file.
+             * @return true if the whole recording was written.
+             * @return false otherwise.
+             */
+            bool close(void);
+
+            /**
+             * @brief Get the number of events written.
+             */
+            uint64_t get_n_events(void) const;
+
+            /**
+             * @brief Get the number of bytes of the frames, as they would be written in full.
+             */
+            uint64_t get_frame_bytes(void) const;
+
+            /**
+             * @brief Get the number of bytes written to the terminal by the events (before the JSON escaping).
+             */
+            uint64_t get_event_bytes(void) const;
+
+        //== Private members
+        private:
+            using Span = std::pair<size_t, size_t>; ///< Offset and size of a line in a text.
+
+            /**
+             * @brief Write the header, padded with spaces to header_len.
+             */
+            void write_header(void);
+
+            std::ofstream file; ///< The recording file.
+            std::string title; ///< The title of the recording.
+            int64_t start_time{0}; ///< When the recording began, in seconds since the epoch.
+            size_t header_len{0}; ///< Size reserved for the header line.
+            size_t width{0}; ///< The widest line of all frames.
+            size_t height{0}; ///< The most lines of a frame.
+            std::string lines, prev_lines; ///< The lines of the current and previous frames, each with the colors it begins with.
+            std::vector<Span> spans, prev_spans; ///< Where each line of the current and previous frames is.
+            std::string payload; ///< What is written to the terminal in the current event (reused).
+            std::string event; ///< The current event, as JSON (reused).
+            uint64_t n_events{0}; ///< Number of events written.
+            uint64_t frame_bytes{0}; ///< Bytes of the frames, in full.
+            uint64_t event_bytes{0}; ///< Bytes written to the terminal by the events.
+    };
+
+    //* This class plays an asciicast file back to the standard output, with the timing of its events.
+    class CastPlayer {
+        //== Public members
+        public:
+            /**
+             * @brief Play a recording.
+             * @param file_name The name of the recording file (it may be compressed as the data files).
+             * @param wait If the time of each event is waited for (otherwise they are written at once).
+             * @param err Where the reason is stored when the file can't be played.
+             * @return true if the whole recording was played.
+             * @return false otherwise.
+             */
+            bool play(const std::string &file_name, bool wait, std::string &err);
+
+            /**
+             * @brief Get the number of events played.
+             */
+            uint64_t get_n_events(void) const;
+
+            /**
+             * @brief Read a JSON string (without its quotes) back to its bytes.
+             * @param str The JSON string, from the first character after the opening quote.
+             * @param out Where the bytes will be appended.
+             * @return size_t The number of characters read up to the closing quote, or std::string::npos if it's broken.
+             */
+            static size_t decode_string(std::string_view str, std::string &out);
+
+        //== Private members
+        private:
+            uint64_t n_events{0}; ///< Number of events played.
+    };
+}
+
+#endif
@@ -15,10 +15,11 @@
 #include <memory> ///< To use shared_ptr (smart pointer).
 #include <vector> ///< To use vector and its methods.
 #include <iomanip> ///< To use setw and setfill.
+#include <string_view> ///< To look for a category without copying it.
+#include <unordered_map> ///< To find the id of a category.
 
 #include "../lib/text_color.h"
-
-#define MAX_BAR_LEN 45 ///< The max length of a bar.
+#include "value_traits.h"
 
 /**
  * @namespace bcr contains all the classes used in the bar chart race.
@@ -31,8 +32,9 @@ namespace bcr {
             //* Struct to define a bar of the chart.
             struct BarItem {
                 std::string label; //!< The data label.
-                size_t value; //!< The value of the data item to be represented by a single bar in a chart.
-                std::string category; //!< A category the data item belong to.
+                value_t value; //!< The value of the data item to be represented by a single bar in a chart.
+                uint32_t category; //!< The id of the category the data item belong to (see Database::get_categories).
+                int32_t climb{0}; //!< Places gained since the previous chart, among its labels (see Ranker).
             };
 
             /**
@@ -65,6 +67,12 @@ namespace bcr {
              */
             std::string get_timestamp(void) const;
 
+            /**
+             * @brief Get the time stamp as read from the data file.
+             * @return std::string The time stamp of the records of the bar chart.
+             */
+            std::string get_time(void) const;
+
         //== Private attributes
         private:
             std::vector<BarItem> bars; ///< Collection of bars.
@@ -104,12 +112,32 @@ namespace bcr {
              * @param source_info The data information reference.
              */
             void set_source_info(std::string source_info);
+
+            /**
+             * @brief Get the id of a category, adding it if it's new.
+             * @param name The name of the category.
+             * @return uint32_t The id of the category.
+             */
+            uint32_t add_category(std::string_view name);
+
+            /**
+             * @brief Get the categories object.
+             * @return const std::vector<std::string>& The name of each category, indexed by its id.
+             */
+            const std::vector<std::string>& get_categories(void) const;
             
             /**
              * @brief Get the current chart of the data_set object.
              * @return std::shared_ptr<BarChart> A smart pointer to the current chart.
              */
             std::shared_ptr<BarChart> get_chart(void);
+
+            /**
+             * @brief Get a chart of the data_set object.
+             * @param index The index of the chart.
+             * @return std::shared_ptr<BarChart> A smart pointer to the chart.
+             */
+            std::shared_ptr<BarChart> get_chart(std::size_t index);
             
             /**
              * @brief Get the number of bar charts in the data.
@@ -148,6 +176,8 @@ namespace bcr {
             std::string main_title; ///< The title of the chart.
             std::string chart_label; ///< The label associated with the value portrayed in the chart.
             std::string chart_source_info; ///< The source of information.
+            std::vector<std::string> categories; ///< All categories of the data, indexed by id.
+            std::unordered_map<std::string, uint32_t> category_ids; ///< The id of each category.
     };
 }
 
@@ -0,0 +1,93 @@
+#ifndef _COLOR_TABLE_H_
+#define _COLOR_TABLE_H_
+
+/*!
+ * @file color_table.h
+ * @author João Guilherme Lopes Alves da Costa (joguicosta@hotmail.com)
+ * @brief Class that gives a stable color to each category of the data.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#include <cstdint> ///< To use uint32_t.
+#include <string> ///< To use string ans its methods.
+#include <vector> ///< To use vector and its methods.
+
+/**
+ * @namespace bcr contains all the classes used in the bar chart race.
+ */
+namespace bcr {
+    //* This class matches each category (by its id) with the escape sequences of its color.
+    class ColorTable {
+        //== Public members
+        public:
+            //* Enumeration of the color depths a terminal may support.
+            enum Depth {
+                AUTO = 0, //!< Choose by the number of categories and the terminal.
+                BASIC, //!< The 14 colors of Color::color_list.
+                EXTENDED, //!< The 256 colors palette.
+                TRUECOLOR, //!< 24 bits colors.
+            };
+
+            /**
+             * @brief Give a color to each category. Each name is hashed to a palette slot, and a taken slot
+             * goes to the next free one, visiting the names in order. So the colors are the same in every run
+             * with the same set of categories, but another set may move some of them.
+             * @param categories The name of each category, indexed by its id.
+             * @param depth The color depth to use.
+             * @param shared Other categories the colors are shared with (e.g. of all races shown together).
+             */
+            void assign(const std::vector<std::string> &categories, Depth depth,
+                        const std::vector<std::string> &shared = {});
+
+            /**
+             * @brief Get the escape sequence that begins a text with the color of a category.
+             * @param id The id of the category.
+             * @param bold If the text is bold.
+             * @return const std::string& The escape sequence.
+             */
+            const std::string& begin(uint32_t id, bool bold) const;
+
+            /**
+             * @brief Color a text with the color of a category.
+             * @param msg The text.
+             * @param id The id of the category.
+             * @param bold If the text is bold.
+             * @return std::string The colored text.
+             */
+            std::string tcolor(const std::string &msg, uint32_t id, bool bold) const;
+
+            /**
+             * @brief Get the depth object.
+             * @return Depth The color depth in use.
+             */
+            Depth get_depth(void) const;
+
+            /**
+             * @brief Get the name of a color depth.
+             * @param depth The color depth.
+             * @return const char* The name of the depth (e.g. "256").
+             */
+            static const char* depth_name(Depth depth);
+
+            /**
+             * @brief Read a color depth from a text ("16", "256" or "truecolor").
+             * @param str The text.
+             * @param depth Where the depth will be stored.
+             * @return true if the text is a valid depth.
+             * @return false otherwise.
+             */
+            static bool parse_depth(const std::string &str, Depth &depth);
+
+        //== Private members
+        private:
+            Depth depth{BASIC}; ///< The color depth in use.
+            std::vector<std::string> regular; ///< Escape sequence of each category (regular text).
+            std::vector<std::string> bold; ///< Escape sequence of each category (bold text).
+    };
+}
+
+#endif
@@ -0,0 +1,265 @@
+#ifndef _DATA_VALIDATOR_H_
+#define _DATA_VALIDATOR_H_
+
+/*!
+ * @file data_validator.h
+ * @author João Guilherme Lopes Alves da Costa (joguicosta@hotmail.com)
+ * @brief Class that checks a data file and reports every problem found in it.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#include <iostream> ///< To use ostream.
+#include <string> ///< To use string ans its methods.
+#include <string_view> ///< To look at the lines without copying them.
+#include <vector> ///< To use vector and its methods.
+
+#include "value_traits.h"
+
+/**
+ * @namespace bcr contains all the classes used in the bar chart race.
+ */
+namespace bcr {
+    class InputSource;
+
+    //* This class validates a data file in parallel chunks and collects all the issues found.
+    class DataValidator {
+        //== Public members
+        public:
+            //* Enumeration of the problems that a data file may have.
+            enum IssueCode {
+                NONE = 0, //!< No problem found.
+                UNREADABLE, //!< The file couldn't be opened or mapped.
+                MISSING_HEADER, //!< The file ends before the title, label and source lines.
+                BAD_COUNT, //!< A block header that isn't a valid number of bars.
+                COUNT_MISMATCH, //!< A block with less records than its header declares.
+                ORPHAN_RECORD, //!< Records that don't belong to any block.
+                BLANK_IN_BLOCK, //!< A blank line before the block has all its records.
+                FIELD_COUNT, //!< A record with less than 5 fields.
+                EMPTY_FIELD, //!< A record with an empty time stamp or label.
+                BAD_VALUE, //!< A record whose value isn't a valid number (of the type value_t).
+                TIMESTAMP_ORDER, //!< A record whose time stamp is older than the previous one.
+            };
+
+            //* Struct to define a single problem found in the file.
+            struct Issue {
+                size_t line; //!< The line (1-based) where the problem is.
+                size_t byte; //!< The byte offset of the beginning of that line.
+                IssueCode code; //!< The kind of problem.
+                std::string message; //!< A human readable description.
+            };
+
+            //* Struct with the fields of a record line: time_stamp, label, other_related_info, value, category.
+            struct RecordFields {
+                std::string_view time; //!< The time stamp of the record.
+                std::string_view label; //!< The data label.
+                std::string_view info; //!< Other related information (not used).
+                std::string_view value; //!< The value, as text.
+                std::string_view category; //!< The category of the record.
+            };
+
+            /**
+             * @brief Construct a new validator.
+             * @param n_threads Number of threads used to scan the file (0 means one per core).
+             */
+            DataValidator(size_t n_threads = 0);
+
+            /**
+             * @brief Scan the whole file and collect every issue found.
+             * @param file_name The name of file that will be validated.
+             * @return true if the file has no issues.
+             * @return false otherwise.
+             */
+            bool validate(const std::string &file_name);
+
+            /**
+             * @brief Prints out the issues, one per line, as tab separated values:
+             * line, byte offset, issue code and message.
+             * @param os The stream where the report will be written.
+             */
+            void report(std::ostream &os) const;
+
+            /**
+             * @brief Get the issues object.
+             * @return const std::vector<Issue>& The issues found, sorted by line.
+             */
+            const std::vector<Issue>& get_issues(void) const;
+
+            /**
+             * @brief Get the number of blocks (bar charts) found.
+             * @return size_t Number of block headers in the file.
+             */
+            size_t get_n_blocks(void) const;
+
+            /**
+             * @brief Get the number of blocks that have at least one issue.
+             * @return size_t Number of corrupt blocks.
+             */
+            size_t get_n_bad_blocks(void) const;
+
+            /**
+             * @brief Get the number of lines of the file.
+             * @return size_t Number of lines scanned.
+             */
+            size_t get_n_lines(void) const;
+
+            /**
+             * @brief Get the short name of an issue code, used in the report.
+             * @param code The issue code.
+             * @return const char* The name of the code (e.g. "bad-value").
+             */
+            static const char* code_name(IssueCode code);
+
+            /**
+             * @brief Check if a line is empty or has only spaces.
+             * @param line The line to check.
+             * @return true if the line is blank.
+             * @return false otherwise.
+             */
+            static bool is_blank(std::string_view line);
+
+            /**
+             * @brief Read the number of bars from a block header (a line with only a number).
+             * @param line The line to parse.
+             * @param n_bars Where the number of bars will be stored.
+             * @return true if the line is a valid block header.
+             * @return false otherwise.
+             */
+            static bool parse_block_header(std::string_view line, size_t &n_bars);
+
+            /**
+             * @brief Split a record line into its fields and check them.
+             * @param line The line to parse.
+             * @param fields Where the fields will be stored.
+             * @param value Where the parsed value will be stored.
+             * @return IssueCode NONE if the record is valid, the problem found otherwise.
+             */
+            static IssueCode parse_record(std::string_view line, RecordFields &fields, value_t &value);
+
+            /**
+             * @brief Split a record whose commas are already known (see LineReader) and read its value.
+             * @param line The line of the record.
+             * @param commas The offsets of the commas of the line, in order.
+             * @param n_commas The number of commas.
+             * @param fields Where the fields will be stored.
+             * @param value Where the value will be stored.
+             * @return IssueCode NONE if the record is valid, or its issue.
+             */
+            static IssueCode parse_record(std::string_view line, const uint32_t *commas, size_t n_commas,
+                                          RecordFields &fields, value_t &value);
+
+            /**
+             * @brief Compare two time stamps. Time stamps with only digits are compared as
+             * numbers, the other ones (e.g. dates in ISO format) as text.
+             * @param a The first time stamp.
+             * @param b The second time stamp.
+             * @return int Negative if a < b, zero if they are equal and positive if a > b.
+             */
+            static int compare_timestamps(std::string_view a, std::string_view b);
+
+        //== Private members
+        private:
+            //* Kinds of runs of lines found while scanning a chunk.
+            enum SegmentKind {
+                HEADER = 0, //!< A single block header.
+                RECORDS, //!< Consecutive record lines.
+                BLANKS, //!< Consecutive blank lines.
+            };
+
+            //* Struct that summarizes a run of lines of the same kind.
+            struct Segment {
+                SegmentKind kind; //!< What the lines are.
+                size_t line; //!< First line of the run (relative to the chunk).
+                size_t byte; //!< Byte offset of the first line.
+                size_t count; //!< Number of lines (or the number of bars, for a header).
+            };
+
+            //* Struct with the result of scanning a single chunk.
+            struct ChunkResult {
+                size_t n_lines{0}; //!< Number of lines in the chunk.
+                std::vector<Segment> segments; //!< Runs of lines, in order.
+                std::vector<Issue> issues; //!< Problems that depend only on a single line.
+                std::string_view first_time; //!< Time stamp of the first record of the chunk.
+                std::string_view last_time; //!< Time stamp of the last record of the chunk.
+                size_t first_time_line{0}; //!< Line of the first record (relative to the chunk).
+                size_t first_time_byte{0}; //!< Byte offset of the first record.
+            };
+
+            /**
+             * @brief Scan a chunk of the file line by line.
+             * @param begin First byte of the chunk (always the beginning of a line).
+             * @param end One past the last byte of the chunk.
+             * @param base_byte The byte offset of begin in the file.
+             * @param res Where the result will be stored.
+             */
+            static void scan_chunk(const char *begin, const char *end, size_t base_byte, ChunkResult &res);
+
+            //* Struct with what is carried from a chunk to the next one while they are stitched.
+            struct StitchState {
+                size_t line_base{4}; //!< Line number of the first line of the next chunk (after the title, label and source).
+                std::string prev_time; //!< Time stamp of the last record stitched.
+                SegmentKind last_kind{HEADER}; //!< Kind of the last run of lines (a header never goes on).
+                Segment header{HEADER, 0, 0, 0}; //!< The header of the current block.
+                size_t declared{0}; //!< Records declared by the header of the current block.
+                size_t remaining{0}; //!< Records still expected for the current block.
+                size_t last_line{0}; //!< The last line of the current block.
+                size_t orphan_issue{0}; //!< The issue of the last run of orphan records.
+                size_t n_orphans{0}; //!< Lines of the last run of orphan records (0 if the run is over).
+            };
+
+            /**
+             * @brief Scan a mapped file in parallel chunks.
+             * @param data The mapped file.
+             * @param size The size of the mapped file.
+             * @return true if the file has the title, label and source lines.
+             * @return false otherwise.
+             */
+            bool scan_mapped(const char *data, size_t size);
+
+            /**
+             * @brief Scan a file chunk by chunk, as it's read, so only a chunk is in memory.
+             * @param source The opened file.
+             * @param file_name The name of the file.
+             * @return true if the file was read and has the title, label and source lines.
+             * @return false otherwise.
+             */
+            bool scan_stream(InputSource &source, const std::string &file_name);
+
+            /**
+             * @brief Join the result of the next chunk to the ones before it, checking the blocks and
+             * the time stamps that cross chunk boundaries. The chunks must be stitched in file order.
+             * @param res The result of the chunk.
+             * @param begin First byte of the chunk.
+             * @param end One past the last byte of the chunk.
+             * @param base_byte The byte offset of begin in the file.
+             */
+            void stitch(ChunkResult &res, const char *begin, const char *end, size_t base_byte);
+
+            /**
+             * @brief Close the last block, after all chunks were stitched.
+             */
+            void finish_stitch(void);
+
+            /**
+             * @brief Store the first and last lines of the current block.
+             */
+            void close_block(void);
+
+            /**
+             * @brief Store a new issue.
+             */
+            void add_issue(size_t line, size_t byte, IssueCode code, std::string message);
+
+            size_t n_threads; ///< Number of threads used to scan the file.
+            std::vector<Issue> issues; ///< All issues found.
+            std::vector<std::pair<size_t, size_t>> blocks; ///< First and last line of each block.
+            size_t n_bad_blocks{0}; ///< Number of blocks with issues.
+            size_t n_lines{0}; ///< Number of lines in the file.
+            StitchState stitching; ///< The state of the stitching of the chunks.
+    };
+}
+
+#endif
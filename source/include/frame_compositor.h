@@ -0,0 +1,73 @@
+#ifndef _FRAME_COMPOSITOR_H_
+#define _FRAME_COMPOSITOR_H_
+
+/*!
+ * @file frame_compositor.h
+ * @author João Guilherme Lopes Alves da Costa (joguicosta@hotmail.com)
+ * @brief Class that puts the frames of several races side by side, in a grid.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#include <string> ///< To use string ans its methods.
+#include <string_view> ///< To split the frames in lines without copying them.
+#include <vector> ///< To use vector and its methods.
+
+/**
+ * @namespace bcr contains all the classes used in the bar chart race.
+ */
+namespace bcr {
+    //* This class composes the frames of several races (as drawn by FrameRenderer) in a single text,
+    // with the races in a grid of cells. The cost is linear in the size of the frames.
+    class FrameCompositor {
+        //== Public members
+        public:
+            /**
+             * @brief Construct a new compositor.
+             * @param n_columns Number of cells in a row of the grid.
+             * @param cell_width Width of a cell, in columns of the terminal (longer lines are cut).
+             */
+            FrameCompositor(size_t n_columns = 1, size_t cell_width = 90);
+
+            /**
+             * @brief Get the number of columns that fit a number of races in a square-ish grid.
+             * @param n_races Number of races.
+             * @return size_t The number of cells in a row.
+             */
+            static size_t columns_for(size_t n_races);
+
+            /**
+             * @brief Put the frames in the grid, row by row.
+             * @param frames The text of the frame of each race.
+             * @param out Where the composed frame will be appended.
+             */
+            void compose(const std::vector<std::string_view> &frames, std::string &out);
+
+            /**
+             * @brief Get the number of columns of the terminal a line takes (the escape sequences take none).
+             * @param line The line, without its newline.
+             * @return size_t The number of characters (UTF-8) out of the escape sequences.
+             */
+            static size_t width_of(std::string_view line);
+
+        //== Private members
+        private:
+            /**
+             * @brief Append a line to a cell: the escape sequences are copied as they are, and the
+             * visible characters (UTF-8) are counted, cutting the line at the width of the cell.
+             * @param line The line of a frame.
+             * @param pad If the cell is filled with spaces up to its width.
+             * @param out Where the cell will be appended.
+             */
+            void append_cell(std::string_view line, bool pad, std::string &out) const;
+
+            size_t n_columns; ///< Number of cells in a row of the grid.
+            size_t cell_width; ///< Width of a cell, in columns of the terminal.
+            std::vector<std::vector<std::string_view>> lines; ///< The lines of each frame of a row (reused).
+    };
+}
+
+#endif
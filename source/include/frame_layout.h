@@ -0,0 +1,256 @@
+#ifndef _FRAME_LAYOUT_H_
+#define _FRAME_LAYOUT_H_
+
+/*!
+ * @file frame_layout.h
+ * @author João Guilherme Lopes Alves da Costa (joguicosta@hotmail.com)
+ * @brief Class that stores the layout of every bar chart, so they are drawn without any computation.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#include <cstdint> ///< To use fixed width integers in the cache file.
+#include <string> ///< To use string ans its methods.
+#include <string_view> ///< To give access to the texts without copying them.
+#include <vector> ///< To use vector and its methods.
+
+#include "bar_chart.h"
+
+/**
+ * @namespace bcr contains all the classes used in the bar chart race.
+ */
+namespace bcr {
+    //* This class holds a compact description of every frame (bar chart) of the animation.
+    class FrameLayout {
+        //== Public members
+        public:
+            //* Struct that describes a single bar of a frame.
+            struct BarDesc {
+                uint64_t text; //!< Offset of the label in the text pool (the value comes right after it).
+                uint32_t label_len; //!< Size of the label.
+                uint32_t value_len; //!< Size of the value, as text.
+                uint32_t length; //!< Length of the bar, in characters.
+                uint32_t category; //!< The id of the category of the bar (it gives the color).
+                int32_t climb; //!< Places gained since the previous chart (see Ranker).
+                uint32_t reserved; //!< Unused (keeps the size a multiple of 8).
+            };
+
+            //* Struct that describes a single frame.
+            struct FrameDesc {
+                uint64_t first_bar; //!< Index of the first bar of the frame.
+                uint64_t timestamp; //!< Offset of the (centered) time stamp in the text pool.
+                uint64_t axis; //!< Offset of the x axis in the text pool.
+                uint32_t n_bars; //!< Number of bars of the frame.
+                uint32_t timestamp_len; //!< Size of the time stamp line.
+                uint64_t axis_len; //!< Size of the x axis.
+                uint64_t time; //!< Offset of the time stamp, as read from the data file, in the text pool.
+                uint64_t time_len; //!< Size of the time stamp, as read.
+            };
+
+            //* Struct that describes an entry of the color legend.
+            struct LegendDesc {
+                uint64_t text; //!< Offset of the category in the text pool.
+                uint32_t len; //!< Size of the category.
+                uint32_t category; //!< The id of the category.
+            };
+
+            //* Struct that identifies the data file and the options a layout was built with.
+            struct Key {
+                uint64_t file_size; //!< Size of the data file.
+                uint64_t file_time; //!< Last modification of the data file (ns).
+                uint64_t n_bars; //!< Max number of bars in a single chart.
+                uint64_t bar_len; //!< The max length of a bar.
+                uint64_t flags; //!< Other options that change the data read.
+                uint64_t value_type; //!< The type of the values (see ValueTraits).
+            };
+
+            /**
+             * @brief Build the key of a data file.
+             * @param file_name The name of the data file.
+             * @param n_bars Max number of bars in a single chart.
+             * @param bar_len The max length of a bar.
+             * @param flags Other options that change the data read.
+             * @param key Where the key will be stored.
+             * @return true if the data file exists.
+             * @return false otherwise.
+             */
+            static bool make_key(const std::string &file_name, size_t n_bars, size_t bar_len, uint64_t flags, Key &key);
+
+            /**
+             * @brief Compute the layout of all bar charts of the data.
+             * @param db The data read from the file.
+             * @param n_bars Max number of bars in a single chart.
+             * @param bar_len The max length of a bar.
+             * @param n_skipped Number of corrupt charts skipped while reading.
+             */
+            void build(Database &db, size_t n_bars, size_t bar_len, size_t n_skipped);
+
+            /**
+             * @brief Store the layout in a file, to be used in the next runs. It's written to a temporary
+             * file first and renamed over the cache, so a reader never sees it half written.
+             * @param file_name The name of the cache file.
+             * @param key The key of the data file and options.
+             * @return true if the layout was saved.
+             * @return false otherwise.
+             */
+            bool save(const std::string &file_name, const Key &key) const;
+
+            /**
+             * @brief Read the layout from a file, if it was built with the same key.
+             * @param file_name The name of the cache file.
+             * @param key The key of the data file and options.
+             * @return true if the layout was read.
+             * @return false if the file doesn't exist, is corrupt or has another key.
+             */
+            bool load(const std::string &file_name, const Key &key);
+
+            /**
+             * @brief Get a text from the text pool.
+             * @param offset The offset of the text.
+             * @param len The size of the text.
+             * @return std::string_view The text.
+             */
+            std::string_view text(uint64_t offset, uint64_t len) const;
+
+            /**
+             * @brief Get a frame.
+             * @param index The index of the frame.
+             * @return const FrameDesc& The description of the frame.
+             */
+            const FrameDesc& get_frame(size_t index) const;
+
+            /**
+             * @brief Get the time stamp of a frame, as read from the data file (to line up the races).
+             * @param index The index of the frame.
+             * @return std::string_view The time stamp.
+             */
+            std::string_view get_time(size_t index) const;
+
+            /**
+             * @brief Get a bar.
+             * @param index The index of the bar (among all frames).
+             * @return const BarDesc& The description of the bar.
+             */
+            const BarDesc& get_bar(size_t index) const;
+
+            /**
+             * @brief Get the legend object.
+             * @return const std::vector<LegendDesc>& The entries of the color legend, sorted by name.
+             */
+            const std::vector<LegendDesc>& get_legend(void) const;
+
+            /**
+             * @brief Get the number of frames.
+             * @return size_t The number of bar charts.
+             */
+            size_t get_n_frames(void) const;
+
+            /**
+             * @brief Get the number of categories of the data.
+             * @return size_t Number of different categories.
+             */
+            size_t get_n_categories(void) const;
+
+            /**
+             * @brief Get the categories object.
+             * @return std::vector<std::string> The name of each category, indexed by its id.
+             */
+            std::vector<std::string> get_categories(void) const;
+
+            /**
+             * @brief Get the number of corrupt charts skipped while reading.
+             * @return size_t Number of charts skipped.
+             */
+            size_t get_n_skipped(void) const;
+
+            /**
+             * @brief Get the centered main title.
+             * @return std::string_view The main title line.
+             */
+            std::string_view get_title_line(void) const;
+
+            /**
+             * @brief Get the main title.
+             * @return std::string_view The main title.
+             */
+            std::string_view get_title(void) const;
+
+            /**
+             * @brief Get the label associated with the value.
+             * @return std::string_view The label.
+             */
+            std::string_view get_label(void) const;
+
+            /**
+             * @brief Get the data information reference.
+             * @return std::string_view The source.
+             */
+            std::string_view get_source_info(void) const;
+
+        //== Private members
+        private:
+            /**
+             * @brief Add a text to the text pool.
+             * @param str The text that will be added.
+             * @return uint64_t The offset of the text.
+             */
+            uint64_t add_text(std::string_view str);
+
+            /**
+             * @brief Check if a text is inside the text pool.
+             * @param offset The offset of the text.
+             * @param len The size of the text.
+             * @return true if the whole text is in the pool.
+             * @return false otherwise.
+             */
+            bool in_pool(uint64_t offset, uint64_t len) const;
+
+            /**
+             * @brief Check that every offset, index and category of a layout read from a file is in range.
+             * @return true if the layout can be drawn.
+             * @return false otherwise.
+             */
+            bool is_consistent(void) const;
+
+            /**
+             * @brief Get the axis x from a collection of bars.
+             * @param n_bars The number of bars that will be printed.
+             * @param bar_len The max length of a bar.
+             * @param bis The bars that compose the bar chart.
+             * @return std::string the axis x that will be displayed (without the label).
+             */
+            static std::string build_axis(size_t n_bars, size_t bar_len, const std::vector<BarChart::BarItem> &bis);
+
+            /**
+             * @brief Center a text in the width of the chart.
+             * @param str The text to center.
+             * @param bar_len The max length of a bar (the chart is twice as wide).
+             * @return std::string The text with spaces before it.
+             */
+            static std::string center(const std::string &str, size_t bar_len);
+
+            //* Struct with the positions of the texts shared by all frames.
+            struct Meta {
+                uint64_t title_line; //!< Offset of the centered main title.
+                uint64_t title_line_len; //!< Size of the centered main title.
+                uint64_t title_len; //!< Size of the main title (it ends the centered title).
+                uint64_t label; //!< Offset of the label.
+                uint64_t label_len; //!< Size of the label.
+                uint64_t source; //!< Offset of the source.
+                uint64_t source_len; //!< Size of the source.
+                uint64_t n_categories; //!< Number of categories of the data.
+                uint64_t n_skipped; //!< Number of corrupt charts skipped.
+            };
+
+            Meta meta{}; ///< The texts shared by all frames.
+            std::vector<FrameDesc> frames; ///< All frames, in order.
+            std::vector<BarDesc> bars; ///< The bars of all frames.
+            std::vector<LegendDesc> legend; ///< The color legend (all categories, sorted by name).
+            std::string pool; ///< All texts used by the frames.
+    };
+}
+
+#endif
@@ -0,0 +1,202 @@
+#ifndef _FRAME_RENDERER_H_
+#define _FRAME_RENDERER_H_
+
+/*!
+ * @file frame_renderer.h
+ * @author João Guilherme Lopes Alves da Costa (joguicosta@hotmail.com)
+ * @brief Classes that draw the frames of the layout, specialized at compile time for each bar width and color depth.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#include <array> ///< To use array.
+#include <charconv> ///< To write the places gained without allocating.
+#include <cstring> ///< To use memcpy.
+#include <memory> ///< To use unique_ptr.
+#include <string> ///< To use string ans its methods.
+#include <vector> ///< To use vector and its methods.
+
+#include "../lib/text_color.h"
+#include "color_table.h"
+#include "frame_layout.h"
+
+/**
+ * @namespace bcr contains all the classes used in the bar chart race.
+ */
+namespace bcr {
+    //* The bar widths with a compiled renderer (see the option -w).
+    static constexpr std::array<size_t, 5> BAR_WIDTHS{30, 45, 60, 90, 120};
+    //* The width of the largest bar when no other is chosen.
+    static constexpr size_t DEFAULT_BAR_WIDTH{45};
+
+    //* Table with the text of the longest bar of a width. The bar of length n is its first n * GLYPH_LEN bytes.
+    template <size_t WIDTH>
+    struct BarGlyphs {
+        static constexpr char GLYPH[]{"█"}; //!< The glyph of a bar cell (UTF-8).
+        static constexpr size_t GLYPH_LEN{sizeof(GLYPH) - 1}; //!< Size of the glyph.
+
+        //* Repeat the glyph WIDTH times.
+        static constexpr std::array<char, WIDTH * GLYPH_LEN> make(void) {
+            std::array<char, WIDTH * GLYPH_LEN> text{};
+            for (size_t i{0}; i < WIDTH * GLYPH_LEN; i++) {
+                text[i] = GLYPH[i % GLYPH_LEN];
+            }
+            return text;
+        }
+
+        static constexpr std::array<char, WIDTH * GLYPH_LEN> text{make()}; //!< The longest bar.
+    };
+
+    //* This class draws a frame of the layout in a text ready to be written to the terminal.
+    class FrameRenderer {
+        //== Public members
+        public:
+            virtual ~FrameRenderer() = default;
+
+            /**
+             * @brief Draw a frame.
+             * @param layout The layout of the charts.
+             * @param index The index of the frame.
+             * @param out Where the text will be appended (its memory may be reused between frames).
+             */
+            virtual void render(const FrameLayout &layout, size_t index, std::string &out) const = 0;
+
+            /**
+             * @brief Draw the titles of a race that didn't reach its first chart yet, and when it starts.
+             * @param layout The layout of the charts (with at least one frame).
+             * @param out Where the text will be appended.
+             */
+            virtual void render_waiting(const FrameLayout &layout, std::string &out) const = 0;
+
+            /**
+             * @brief Create the renderer of a bar width and color depth.
+             * @param width The width of the largest bar (one of BAR_WIDTHS).
+             * @param colors The colors of the categories (already assigned).
+             * @param n_categories Number of categories of the data.
+             * @param legend The color legend, ready to be displayed.
+             * @param overtakes If the bars that went up in the ranking are marked.
+             * @return std::unique_ptr<FrameRenderer> The renderer, or nullptr if the width isn't supported.
+             */
+            static std::unique_ptr<FrameRenderer> create(size_t width, const ColorTable &colors, size_t n_categories,
+                                                         const std::string &legend, bool overtakes);
+
+            /**
+             * @brief Check if a bar width has a renderer.
+             * @param width The width of the largest bar.
+             * @return true if it's one of BAR_WIDTHS.
+             * @return false otherwise.
+             */
+            static bool supported(size_t width);
+    };
+
+    //* Renderer of a bar width and color depth. The escape sequences of the categories are stored
+    // in slots of a fixed size (the longest sequence of the depth), and each bar is copied from BarGlyphs.
+    template <size_t WIDTH, ColorTable::Depth DEPTH>
+    class BasicFrameRenderer : public FrameRenderer {
+        //== Public members
+        public:
+            //* The size of the longest escape sequence of the depth ("\e[1;97m", "\e[1;38;5;255m" or "\e[1;38;2;255;255;255m").
+            static constexpr size_t ESCAPE_MAX{DEPTH == ColorTable::BASIC ? 8 : (DEPTH == ColorTable::EXTENDED ? 16 : 24)};
+
+            /**
+             * @brief Construct a new renderer.
+             * @param colors The colors of the categories (already assigned).
+             * @param n_categories Number of categories of the data.
+             * @param legend The color legend, ready to be displayed.
+             * @param overtakes If the bars that went up in the ranking are marked.
+             */
+            BasicFrameRenderer(const ColorTable &colors, size_t n_categories, const std::string &legend, bool overtakes)
+                : escapes(n_categories), legend{legend}, overtakes{overtakes} {
+                for (size_t id{0}; id < n_categories; id++) {
+                    copy(colors.begin(id, false), escapes[id].regular, escapes[id].regular_len);
+                    copy(colors.begin(id, true), escapes[id].bold, escapes[id].bold_len);
+                }
+            }
+
+            void render(const FrameLayout &layout, size_t index, std::string &out) const override {
+                using Glyphs = BarGlyphs<WIDTH>;
+                static constexpr Color::Escape title_color{Color::escape(Color::BLUE, Color::BOLD)};
+                static constexpr Color::Escape label_color{Color::escape(Color::YELLOW, Color::BOLD)};
+                static constexpr Color::Escape source_color{Color::escape(Color::WHITE, Color::BOLD)};
+                static constexpr Color::Escape climb_color{Color::escape(Color::BRIGHT_GREEN, Color::BOLD)};
+                const FrameLayout::FrameDesc &frame = layout.get_frame(index);
+                //* [1] The titles.
+                out.append(title_color.text, title_color.len);
+                out.append(layout.get_title_line()).append("\n\n");
+                out.append(layout.text(frame.timestamp, frame.timestamp_len)).append("\n\n");
+                out.append(Color::RESET, Color::RESET_LEN);
+                //* [2] The bars: each one is a prefix of the longest bar.
+                for (size_t i{0}; i < frame.n_bars; i++) {
+                    const FrameLayout::BarDesc &bar = layout.get_bar(frame.first_bar + i);
+                    const CategoryEscapes &esc = escapes[bar.category];
+                    size_t length = bar.length < WIDTH ? bar.length : WIDTH;
+                    if (length > 0) {
+                        out.append(esc.regular, esc.regular_len);
+                        out.append(Glyphs::text.data(), length * Glyphs::GLYPH_LEN);
+                        out.append(Color::RESET, Color::RESET_LEN);
+                    }
+                    out += ' ';
+                    out.append(esc.bold, esc.bold_len);
+                    out.append(layout.text(bar.text, bar.label_len));
+                    out.append(Color::RESET, Color::RESET_LEN).append(" [");
+                    out.append(layout.text(bar.text + bar.label_len, bar.value_len)).append("]");
+                    if (overtakes and bar.climb > 0) {
+                        char places[16];
+                        auto res = std::to_chars(places, places + sizeof(places), bar.climb);
+                        out.append(" ").append(climb_color.text, climb_color.len).append("▲");
+                        out.append(places, res.ptr).append(Color::RESET, Color::RESET_LEN);
+                    }
+                    out.append("\n\n");
+                }
+                //* [3] The x axis, its label, the source and the legend.
+                out.append(layout.text(frame.axis, frame.axis_len));
+                out.append(label_color.text, label_color.len);
+                out.append(layout.get_label());
+                out.append(Color::RESET, Color::RESET_LEN).append("\n\n");
+                out.append(source_color.text, source_color.len);
+                out.append(layout.get_source_info());
+                out.append(Color::RESET, Color::RESET_LEN).append("\n");
+                out.append(legend).append("\n\n");
+            }
+
+            void render_waiting(const FrameLayout &layout, std::string &out) const override {
+                static constexpr Color::Escape title_color{Color::escape(Color::BLUE, Color::BOLD)};
+                static constexpr char WAITING[]{"Waiting for: "};
+                std::string_view time = layout.get_time(0);
+                size_t len = sizeof(WAITING) - 1 + time.size();
+                out.append(title_color.text, title_color.len);
+                out.append(layout.get_title_line()).append("\n\n");
+                // Centered as the time stamps of the charts.
+                out.append(len < WIDTH * 2 ? (WIDTH * 2 - len) / 2 : 0, ' ');
+                out.append(WAITING).append(time).append("\n\n");
+                out.append(Color::RESET, Color::RESET_LEN);
+            }
+
+        //== Private members
+        private:
+            //* Struct with the escape sequences of a category.
+            struct CategoryEscapes {
+                char regular[ESCAPE_MAX]; //!< Begins a regular text.
+                char bold[ESCAPE_MAX]; //!< Begins a bold text.
+                size_t regular_len{0}; //!< Size of the regular sequence.
+                size_t bold_len{0}; //!< Size of the bold sequence.
+            };
+
+            /**
+             * @brief Copy an escape sequence to a slot (it's cut if it doesn't fit, which the depth never gives).
+             */
+            static void copy(const std::string &seq, char *slot, size_t &len) {
+                len = seq.size() < ESCAPE_MAX ? seq.size() : ESCAPE_MAX;
+                std::memcpy(slot, seq.data(), len);
+            }
+
+            std::vector<CategoryEscapes> escapes; ///< The escape sequences of each category.
+            std::string legend; ///< The color legend, ready to be displayed.
+            bool overtakes; ///< If the bars that went up in the ranking are marked.
+    };
+}
+
+#endif
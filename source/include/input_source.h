@@ -0,0 +1,371 @@
+#ifndef _INPUT_SOURCE_H_
+#define _INPUT_SOURCE_H_
+
+/*!
+ * @file input_source.h
+ * @author João Guilherme Lopes Alves da Costa (joguicosta@hotmail.com)
+ * @brief Classes that read the data file in large chunks, ahead of the parser.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#include <condition_variable> ///< To wait for the chunks.
+#include <cstdint> ///< To use uint64_t.
+#include <memory> ///< To use unique_ptr.
+#include <mutex> ///< To share the chunks with the reader threads.
+#include <string> ///< To use string ans its methods.
+#include <string_view> ///< To give the lines without copying them.
+#include <thread> ///< To read the file in background.
+#include <vector> ///< To use vector and its methods.
+
+#include "struct_indexer.h"
+
+/**
+ * @namespace bcr contains all the classes used in the bar chart race.
+ */
+namespace bcr {
+    //* Struct with the statistics of a reading, to see how long the parser waits for the disk.
+    struct IoStats {
+        uint64_t bytes{0}; //!< Bytes given to the parser.
+        uint64_t chunks{0}; //!< Chunks given to the parser.
+        uint64_t wait_ns{0}; //!< Time the parser waited for the data (ns).
+        uint64_t major_faults{0}; //!< Page faults that needed the disk.
+        bool mapped{false}; //!< If the file was mapped into memory (otherwise it was read by threads).
+        uint64_t compressed_bytes{0}; //!< Bytes read from the file, when it's compressed.
+    };
+
+    //* This class gives the content of a file in large chunks, in order.
+    class InputSource {
+        //== Public members
+        public:
+            //* Enumeration of the ways of reading the file.
+            enum Mode {
+                MMAP = 0, //!< Map the file into memory (the default for regular files).
+                PREAD, //!< Read the file with a pool of threads.
+            };
+
+            //* Enumeration of the compression formats of the file, found by its first bytes.
+            enum Compression {
+                NONE = 0, //!< Plain text.
+                GZIP, //!< gzip (1f 8b).
+                ZSTD, //!< zstd (28 b5 2f fd).
+            };
+
+            //* Struct with a piece of the file. It's valid until the next call to next().
+            struct Chunk {
+                const char *data{nullptr}; //!< The first byte.
+                size_t size{0}; //!< The number of bytes.
+            };
+
+            InputSource(void);
+            virtual ~InputSource(void) = default;
+
+            /**
+             * @brief Get the next chunk of the file, waiting for it if needed.
+             * @param chunk Where the chunk will be stored.
+             * @return true if there was a chunk.
+             * @return false at the end of the file (or after an error).
+             */
+            virtual bool next(Chunk &chunk) = 0;
+
+            /**
+             * @brief Check if the reading failed.
+             * @return true if there was an error reading the file.
+             * @return false otherwise.
+             */
+            bool failed(void) const;
+
+            /**
+             * @brief Get the stats object.
+             * @return IoStats The statistics of the reading until now.
+             */
+            IoStats get_stats(void) const;
+
+            /**
+             * @brief Get the compression object.
+             * @return Compression The compression of the file (the chunks are always decompressed).
+             */
+            Compression get_compression(void) const;
+
+            /**
+             * @brief Open a file with the given mode. Files that can't be mapped
+             * (e.g. pipes) are always read with PREAD. Compressed files are decompressed
+             * while they are read.
+             * @param file_name The name of the file.
+             * @param mode The way of reading the file.
+             * @param err Where the reason will be stored, if the file can't be opened.
+             * @return std::unique_ptr<InputSource> The source, or nullptr if the file can't be opened.
+             */
+            static std::unique_ptr<InputSource> open(const std::string &file_name, Mode mode, std::string &err);
+
+            /**
+             * @brief Find the compression of a file by its first bytes. Only regular files
+             * are checked (the first bytes of a pipe can't be read twice).
+             * @param file_name The name of the file.
+             * @return Compression The compression of the file.
+             */
+            static Compression detect(const std::string &file_name);
+
+            /**
+             * @brief Check if this build can decompress a format.
+             * @param compression The format.
+             * @return true if it can be read.
+             * @return false otherwise.
+             */
+            static bool supported(Compression compression);
+
+            /**
+             * @brief Get the name of a compression format.
+             * @param compression The format.
+             * @return const char* The name of the format (e.g. "gzip").
+             */
+            static const char* compression_name(Compression compression);
+
+            /**
+             * @brief Get the name of a mode.
+             * @param mode The mode.
+             * @return const char* The name of the mode (e.g. "mmap").
+             */
+            static const char* mode_name(Mode mode);
+
+        //== Protected members
+        protected:
+            IoStats stats; ///< The statistics of the reading.
+            uint64_t start_faults{0}; ///< Major page faults of the process when the source was created.
+            bool error{false}; ///< If the reading failed.
+            Compression compression{NONE}; ///< The compression of the file.
+    };
+
+    //* This class is a bounded queue of buffers, filled in order by background threads and read by the parser.
+    // The buffer of chunk i is buffers[i % n_buffers], so the memory doesn't depend on the size of the file.
+    class ChunkQueue {
+        //== Public members
+        public:
+            /**
+             * @brief Construct a new queue.
+             * @param n_buffers Number of chunks that may be filled ahead of the parser.
+             * @param buffer_size Size of each buffer.
+             */
+            ChunkQueue(size_t n_buffers, size_t buffer_size);
+
+            /**
+             * @brief Limit the number of chunks, when it's known before the end.
+             * @param n_chunks Number of chunks.
+             */
+            void limit(size_t n_chunks);
+
+            /**
+             * @brief Claim the next chunk to be filled, waiting until its buffer is free.
+             * @param index Where the number of the chunk will be stored.
+             * @param buffer Where the buffer will be stored (buffer_size bytes).
+             * @return true if a chunk was claimed.
+             * @return false if there are no more chunks (or the queue was stopped).
+             */
+            bool claim(size_t &index, char *&buffer);
+
+            /**
+             * @brief Give a filled chunk to the parser.
+             * @param index The number of the chunk.
+             * @param size The number of bytes of the chunk.
+             * @param last If it's the last chunk (the queue ends after it, or before it if it's empty).
+             */
+            void publish(size_t index, size_t size, bool last);
+
+            /**
+             * @brief Release the last chunk and get the next one, waiting for it if needed.
+             * @param chunk Where the chunk will be stored.
+             * @param wait_ns Where the time waited will be added (ns).
+             * @return true if there was a chunk.
+             * @return false at the end of the queue.
+             */
+            bool next(InputSource::Chunk &chunk, uint64_t &wait_ns);
+
+            /**
+             * @brief Ask the threads waiting in claim() to give up.
+             */
+            void stop(void);
+
+        //== Private members
+        private:
+            //* Struct with a buffer that receives a chunk.
+            struct Slot {
+                std::unique_ptr<char[]> buffer; //!< The bytes of the chunk (not initialized).
+                size_t size{0}; //!< The number of bytes of the chunk.
+                bool ready{false}; //!< If the chunk was filled and not released by the parser.
+            };
+
+            std::vector<Slot> slots; ///< The buffers.
+            std::mutex mtx; ///< Protects the fields below.
+            std::condition_variable cv_free; ///< Signals the producers that a buffer was released.
+            std::condition_variable cv_ready; ///< Signals the parser that a chunk was filled.
+            size_t next_index{0}; ///< The next chunk to be claimed.
+            size_t released{0}; ///< Number of chunks released by the parser.
+            size_t cursor{0}; ///< The next chunk to be given to the parser.
+            size_t n_chunks{SIZE_MAX}; ///< Number of chunks (known at the end, for pipes).
+            bool stopped{false}; ///< If the producers must give up.
+    };
+
+    //* This class maps the whole file and gives it in windows, asking the kernel to read ahead of them.
+    class MappedSource : public InputSource {
+        //== Public members
+        public:
+            static constexpr size_t WINDOW{8 << 20}; //!< Size of each chunk given to the parser.
+            static constexpr size_t AHEAD{64 << 20}; //!< How far ahead of the parser the file is read.
+
+            ~MappedSource(void);
+
+            /**
+             * @brief Map a file into memory.
+             * @param file_name The name of the file.
+             * @return true if the file was mapped.
+             * @return false otherwise.
+             */
+            bool open(const std::string &file_name);
+
+            bool next(Chunk &chunk) override;
+
+            /**
+             * @brief Ask the kernel to read the whole file now, for readers that don't go in order.
+             */
+            void will_need(void);
+
+            /**
+             * @brief Get the whole mapped file.
+             * @return const char* The first byte of the file.
+             */
+            const char* data(void) const;
+
+            /**
+             * @brief Get the size of the mapped file.
+             * @return size_t The size of the file.
+             */
+            size_t size(void) const;
+
+        //== Private members
+        private:
+            char *addr{nullptr}; ///< The mapped file.
+            size_t length{0}; ///< The size of the file.
+            size_t cursor{0}; ///< Where the next chunk begins.
+            size_t advised{0}; ///< Until where the kernel was asked to read ahead.
+    };
+
+    //* This class reads the file with a pool of threads, in large aligned chunks, ahead of the parser.
+    class ReaderSource : public InputSource {
+        //== Public members
+        public:
+            static constexpr size_t CHUNK{4 << 20}; //!< Size of each chunk (a multiple of the page size).
+
+            /**
+             * @brief Construct a new reader.
+             * @param n_threads Number of reader threads (files that can't seek use only one).
+             * @param n_buffers Number of chunks that may be read ahead of the parser.
+             */
+            ReaderSource(size_t n_threads = 2, size_t n_buffers = 8);
+            ~ReaderSource(void);
+
+            /**
+             * @brief Open a file and start reading it.
+             * @param file_name The name of the file.
+             * @return true if the file was opened.
+             * @return false otherwise.
+             */
+            bool open(const std::string &file_name);
+
+            bool next(Chunk &chunk) override;
+
+        //== Private members
+        private:
+            /**
+             * @brief The work of each reader thread: claim the next chunk while there is a free buffer and read it.
+             */
+            void reader_loop(void);
+
+            int fd{-1}; ///< The file.
+            bool seekable{false}; ///< If the file may be read with pread (regular files).
+            size_t n_threads; ///< Number of reader threads.
+            size_t n_buffers; ///< Number of chunks read ahead of the parser.
+            ChunkQueue queue; ///< The chunks read.
+            std::vector<std::thread> readers; ///< The reader threads.
+    };
+
+    //* This class decompresses a file on its own thread, while the parser reads the chunks decompressed before.
+    class DecompressSource : public InputSource {
+        //== Public members
+        public:
+            static constexpr size_t CHUNK{4 << 20}; //!< Size of each decompressed chunk.
+
+            /**
+             * @brief Construct a new decompressor.
+             * @param raw The source of the compressed bytes.
+             * @param compression The format of the bytes (GZIP or ZSTD, and supported).
+             * @param n_buffers Number of decompressed chunks that may wait for the parser.
+             */
+            DecompressSource(std::unique_ptr<InputSource> raw, Compression compression, size_t n_buffers = 4);
+            ~DecompressSource(void);
+
+            bool next(Chunk &chunk) override;
+
+            struct Decoder; ///< The state of the decompression (zlib or zstd), see input_source.cpp.
+
+        //== Private members
+        private:
+            /**
+             * @brief The work of the decompressing thread: fill each free buffer with the next decompressed bytes.
+             */
+            void decoder_loop(void);
+
+            std::unique_ptr<InputSource> raw; ///< Where the compressed bytes come from.
+            std::unique_ptr<Decoder> decoder; ///< The decompressor.
+            ChunkQueue queue; ///< The decompressed chunks.
+            std::thread worker; ///< The decompressing thread.
+    };
+
+    //* This class splits the chunks of an input source in lines. Each chunk is indexed once
+    // (see StructIndexer), so the lines and the commas of each line are found without scanning it again.
+    class LineReader {
+        //== Public members
+        public:
+            /**
+             * @brief Construct a new line reader.
+             * @param source Where the chunks come from.
+             */
+            LineReader(InputSource &source);
+
+            /**
+             * @brief Get the next line (without the '\n'). It's valid until the next call.
+             * @param line Where the line will be stored.
+             * @return true if there was a line.
+             * @return false at the end of the file.
+             */
+            bool next(std::string_view &line);
+
+            /**
+             * @brief Get the commas object.
+             * @return const std::vector<uint32_t>& The offsets of the commas of the last line.
+             */
+            const std::vector<uint32_t>& get_commas(void) const;
+
+            /**
+             * @brief Get the indexer object.
+             * @return const StructIndexer& The indexer of the chunks.
+             */
+            const StructIndexer& get_indexer(void) const;
+
+        //== Private members
+        private:
+            InputSource &source; ///< Where the chunks come from.
+            InputSource::Chunk chunk; ///< The current chunk.
+            size_t pos{0}; ///< Where the next line begins in the chunk.
+            StructIndexer indexer; ///< Finds the newlines and commas of each chunk.
+            std::vector<uint32_t> structurals; ///< Offsets of the newlines and commas of the chunk.
+            size_t next_struct{0}; ///< The first of the structurals after pos.
+            std::vector<uint32_t> commas; ///< Offsets of the commas of the last line.
+            std::string carry; ///< A line that crosses chunks.
+            bool done{false}; ///< If the source has ended.
+    };
+}
+
+#endif
@@ -0,0 +1,79 @@
+#ifndef _RANKER_H_
+#define _RANKER_H_
+
+/*!
+ * @file ranker.h
+ * @author João Guilherme Lopes Alves da Costa (joguicosta@hotmail.com)
+ * @brief Class that ranks the bars of each chart starting from the ranking of the previous chart.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#include <cstdint> ///< To use uint32_t.
+#include <string> ///< To use string ans its methods.
+#include <unordered_map> ///< To find the previous rank of a label.
+#include <vector> ///< To use vector and its methods.
+
+#include "bar_chart.h"
+
+/**
+ * @namespace bcr contains all the classes used in the bar chart race.
+ */
+namespace bcr {
+    //* This class sorts the bars of the charts of a data file, one chart after the other, from the highest
+    // value to the lowest. Consecutive charts are almost in the same order, so each one starts in the order
+    // of the previous chart (by label) and is repaired with an insertion sort, which costs O(n + swaps).
+    // The swaps are the overtakes of the chart, and the places each bar gains are stored in its climb.
+    class Ranker {
+        //== Public members
+        public:
+            //* The most moves per bar of an insertion sort: a chart that needs more is sorted from scratch.
+            static constexpr size_t MAX_MOVES_PER_BAR{16};
+
+            /**
+             * @brief Rank the bars of the next chart. The bars with the same value keep the order of the
+             * previous chart, and the labels that weren't in it come after them.
+             * @param bars The bars of the chart, that will be sorted (each one gets its climb).
+             */
+            void rank(std::vector<BarChart::BarItem> &bars);
+
+            /**
+             * @brief Get the number of charts ranked by repairing the order of the previous one.
+             */
+            size_t get_n_repaired(void) const;
+
+            /**
+             * @brief Get the number of charts sorted from scratch (too different from the previous one).
+             */
+            size_t get_n_resorted(void) const;
+
+            /**
+             * @brief Get the number of overtakes of all charts repaired.
+             */
+            uint64_t get_n_overtakes(void) const;
+
+        //== Private members
+        private:
+            //* Where a label was in a chart.
+            struct Rank {
+                uint64_t chart; //!< The number of the chart (from 1).
+                uint32_t position; //!< The position of the label in that chart.
+            };
+
+            std::unordered_map<std::string, Rank> ranks; ///< The last rank of each label.
+            uint64_t n_charts{0}; ///< Number of charts ranked.
+            size_t prev_size{0}; ///< Number of bars of the previous chart.
+            size_t n_repaired{0}; ///< Charts ranked from the previous order.
+            size_t n_resorted{0}; ///< Charts sorted from scratch.
+            uint64_t n_overtakes{0}; ///< Overtakes of all charts repaired.
+            std::vector<int32_t> slots; ///< The bar in each position of the previous chart (reused).
+            std::vector<uint32_t> known, newcomers, order; ///< Indices of the bars (reused).
+            std::vector<int32_t> seed; ///< Position of each bar among the known labels, before the repair (-1 if new).
+            std::vector<BarChart::BarItem> sorted; ///< The bars in order (reused).
+    };
+}
+
+#endif
@@ -0,0 +1,99 @@
+#ifndef _STRUCT_INDEXER_H_
+#define _STRUCT_INDEXER_H_
+
+/*!
+ * @file struct_indexer.h
+ * @author João Guilherme Lopes Alves da Costa (joguicosta@hotmail.com)
+ * @brief Class that finds the newlines and commas of a text with SIMD instructions.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#include <cstdint> ///< To use uint64_t.
+#include <vector> ///< To use vector and its methods.
+
+/**
+ * @namespace bcr contains all the classes used in the bar chart race.
+ */
+namespace bcr {
+    //* This class finds the structural characters of the data file ('\n' and ',') in blocks of 64 bytes,
+    // giving a bitmap per character (bit i is set if the byte i of the block is that character).
+    class StructIndexer {
+        //== Public members
+        public:
+            static constexpr size_t BLOCK{64}; //!< Number of bytes of each block (one bit per byte).
+
+            //* Enumeration of the instruction sets that may be used, from the slowest.
+            enum Isa {
+                SCALAR = 0, //!< One byte at a time (any CPU).
+                SSE42, //!< 16 bytes at a time.
+                AVX2, //!< 32 bytes at a time.
+            };
+
+            //* Struct with the bitmaps of a block.
+            struct Bitmaps {
+                uint64_t newlines{0}; //!< Positions of the '\n'.
+                uint64_t commas{0}; //!< Positions of the ','.
+            };
+
+            /**
+             * @brief Construct a new indexer.
+             * @param isa The instruction set to use (it must be supported by the CPU).
+             */
+            StructIndexer(Isa isa = best());
+
+            /**
+             * @brief Get the bitmaps of a block.
+             * @param block The first of BLOCK bytes.
+             * @return Bitmaps The positions of the newlines and commas of the block.
+             */
+            Bitmaps index_block(const char *block) const;
+
+            /**
+             * @brief Find every newline and comma of a text.
+             * @param data The text (less than 4 GB).
+             * @param size The number of bytes.
+             * @param positions Where the offsets of the newlines and commas will be stored, in order.
+             */
+            void index(const char *data, size_t size, std::vector<uint32_t> &positions) const;
+
+            /**
+             * @brief Get the isa object.
+             * @return Isa The instruction set in use.
+             */
+            Isa get_isa(void) const;
+
+            /**
+             * @brief Get the fastest instruction set supported by the CPU.
+             * @return Isa The instruction set.
+             */
+            static Isa best(void);
+
+            /**
+             * @brief Check if the CPU supports an instruction set.
+             * @param isa The instruction set.
+             * @return true if it's supported.
+             * @return false otherwise.
+             */
+            static bool supported(Isa isa);
+
+            /**
+             * @brief Get the name of an instruction set.
+             * @param isa The instruction set.
+             * @return const char* The name (e.g. "avx2").
+             */
+            static const char* isa_name(Isa isa);
+
+        //== Private members
+        private:
+            using BlockFunc = Bitmaps (*)(const char*); ///< The function that indexes a block.
+
+            Isa isa; ///< The instruction set in use.
+            BlockFunc block_func; ///< The function that indexes a block with it.
+    };
+}
+
+#endif
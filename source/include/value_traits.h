@@ -0,0 +1,265 @@
+#ifndef _VALUE_TRAITS_H_
+#define _VALUE_TRAITS_H_
+
+/*!
+ * @file value_traits.h
+ * @author João Guilherme Lopes Alves da Costa (joguicosta@hotmail.com)
+ * @brief Numeric types that may store the value of the bars, and how to parse, scale and print them.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#include <charconv> ///< To parse and print the numbers without copies (from_chars and to_chars).
+#include <cmath> ///< To use floor, log10 and pow.
+#include <cstdint> ///< To use uint64_t.
+#include <limits> ///< To get the max value of the types.
+#include <string> ///< To use string ans its methods.
+#include <string_view> ///< To parse the values without copying them.
+
+/**
+ * @namespace bcr contains all the classes used in the bar chart race.
+ */
+namespace bcr {
+    //* A non negative fixed point number with 4 decimal places.
+    struct Decimal {
+        static constexpr uint64_t SCALE{10000}; //!< Raw units in 1.0.
+        static constexpr size_t DIGITS{4}; //!< Number of decimal places.
+        uint64_t raw{0}; //!< The number multiplied by SCALE.
+
+        friend bool operator<(Decimal a, Decimal b) { return a.raw < b.raw; }
+        friend bool operator>(Decimal a, Decimal b) { return a.raw > b.raw; }
+        friend bool operator<=(Decimal a, Decimal b) { return a.raw <= b.raw; }
+        friend bool operator==(Decimal a, Decimal b) { return a.raw == b.raw; }
+        friend Decimal operator+(Decimal a, Decimal b) { return Decimal{a.raw + b.raw}; }
+        friend Decimal operator-(Decimal a, Decimal b) { return Decimal{a.raw - b.raw}; }
+        friend Decimal operator/(Decimal a, size_t n) { return Decimal{a.raw / n}; }
+        Decimal& operator+=(Decimal b) { raw += b.raw; return *this; }
+    };
+
+    /**
+     * @brief Prints out a number with at most 3 significant digits and a unit
+     * (K, M, B, T, Q or Qi) when it's 1000 or more, e.g. 1500 -> "1.5K".
+     * @param value The number.
+     * @return std::string The short text.
+     */
+    inline std::string short_number(double value) {
+        static constexpr const char *units[]{"", "K", "M", "B", "T", "Q", "Qi"};
+        size_t unit{0};
+        while (value >= 999.5 and unit < 6) {
+            value /= 1000;
+            unit++;
+        }
+        char buf[32];
+        int decimals = (value >= 99.95 or value == std::floor(value)) ? 0 : (value >= 9.995 ? 1 : 2);
+        auto res = std::to_chars(buf, buf + sizeof(buf), value, std::chars_format::fixed, decimals);
+        std::string str(buf, res.ptr);
+        // Remove the zeros after the point (e.g. 1.50 -> 1.5).
+        if (str.find('.') != std::string::npos) {
+            str.erase(str.find_last_not_of('0') + 1);
+            if (str.back() == '.') {
+                str.pop_back();
+            }
+        }
+        return str + units[unit];
+    }
+
+    //* How to parse, scale and print each type of value. Only the specializations are defined.
+    template <typename T>
+    struct ValueTraits;
+
+    //* Integer values (the default): exact and the fastest.
+    template <>
+    struct ValueTraits<uint64_t> {
+        static constexpr uint64_t ID{1}; //!< Identifies the type in the layout cache.
+
+        /**
+         * @brief Read a value from a text.
+         * @param str The text (without spaces).
+         * @param value Where the value will be stored.
+         * @return true if the whole text is a valid value.
+         * @return false otherwise.
+         */
+        static bool parse(std::string_view str, uint64_t &value) {
+            auto [ptr, ec] = std::from_chars(str.data(), str.data() + str.size(), value);
+            return ec == std::errc() and ptr == str.data() + str.size();
+        }
+
+        /**
+         * @brief Compute value * len / max without overflow.
+         * @param value The value of the bar.
+         * @param max The highest value (whose bar has the length len).
+         * @param len The length of the highest bar.
+         * @return size_t The length of the bar.
+         */
+        static size_t scale(uint64_t value, uint64_t max, size_t len) {
+            // The multiplication only overflows for huge values.
+            if (value <= std::numeric_limits<uint64_t>::max() / len) {
+                return (value * len) / max;
+            }
+            return static_cast<size_t>((static_cast<unsigned __int128>(value) * len) / max);
+        }
+
+        /**
+         * @brief The step the axis limits are rounded to: a power of ten that keeps 2 significant digits of the highest value.
+         * @param max The highest value.
+         * @return uint64_t The rounding step.
+         */
+        static uint64_t unit(uint64_t max) {
+            uint64_t step{1};
+            while (max / step >= 100) {
+                step *= 10;
+            }
+            return step;
+        }
+
+        /**
+         * @brief Round a value down to a multiple of the unit.
+         */
+        static uint64_t round_down(uint64_t value, uint64_t unit) {
+            return (value / unit) * unit;
+        }
+
+        /**
+         * @brief Add two values, stopping at the max value of the type.
+         */
+        static uint64_t add(uint64_t a, uint64_t b) {
+            return (a > std::numeric_limits<uint64_t>::max() - b) ? std::numeric_limits<uint64_t>::max() : a + b;
+        }
+
+        /**
+         * @brief Check if a value is bigger than zero.
+         */
+        static bool positive(uint64_t value) {
+            return value > 0;
+        }
+
+        /**
+         * @brief Prints out the exact value.
+         */
+        static std::string to_string(uint64_t value) {
+            return std::to_string(value);
+        }
+
+        /**
+         * @brief Prints out the value with a unit (K, M, B, ...), used in the axis.
+         */
+        static std::string to_short_string(uint64_t value) {
+            return (value < 1000) ? std::to_string(value) : short_number(static_cast<double>(value));
+        }
+    };
+
+    //* Floating point values: any magnitude, with fractions.
+    template <>
+    struct ValueTraits<double> {
+        static constexpr uint64_t ID{2}; //!< Identifies the type in the layout cache.
+
+        static bool parse(std::string_view str, double &value) {
+            auto [ptr, ec] = std::from_chars(str.data(), str.data() + str.size(), value);
+            return ec == std::errc() and ptr == str.data() + str.size() and std::isfinite(value) and value >= 0;
+        }
+        static size_t scale(double value, double max, size_t len) {
+            return static_cast<size_t>((value / max) * len);
+        }
+        // Round the axis to 2 significant digits of the highest value.
+        static double unit(double max) {
+            return (max > 0) ? std::pow(10.0, std::floor(std::log10(max)) - 1) : 1.0;
+        }
+        static double round_down(double value, double unit) {
+            return std::floor(value / unit) * unit;
+        }
+        static double add(double a, double b) {
+            return a + b;
+        }
+        static bool positive(double value) {
+            return value > 0;
+        }
+        static std::string to_string(double value) {
+            char buf[32];
+            auto res = std::to_chars(buf, buf + sizeof(buf), value);
+            return std::string(buf, res.ptr);
+        }
+        static std::string to_short_string(double value) {
+            return short_number(value);
+        }
+    };
+
+    //* Fixed point values: exact fractions (e.g. money) with integer speed.
+    template <>
+    struct ValueTraits<Decimal> {
+        static constexpr uint64_t ID{3}; //!< Identifies the type in the layout cache.
+
+        static bool parse(std::string_view str, Decimal &value) {
+            size_t dot = str.find('.');
+            std::string_view integer = str.substr(0, dot);
+            std::string_view fraction = (dot == std::string_view::npos) ? std::string_view{} : str.substr(dot + 1);
+            uint64_t int_part{0}, frac_part{0};
+            if (integer.empty() or not ValueTraits<uint64_t>::parse(integer, int_part)) {
+                return false;
+            }
+            if (dot != std::string_view::npos) {
+                if (fraction.empty() or fraction.size() > Decimal::DIGITS
+                    or not ValueTraits<uint64_t>::parse(fraction, frac_part)) {
+                    return false;
+                }
+                for (size_t i{fraction.size()}; i < Decimal::DIGITS; i++) {
+                    frac_part *= 10;
+                }
+            }
+            if (int_part > (std::numeric_limits<uint64_t>::max() - frac_part) / Decimal::SCALE) {
+                return false;
+            }
+            value.raw = int_part * Decimal::SCALE + frac_part;
+            return true;
+        }
+        static size_t scale(Decimal value, Decimal max, size_t len) {
+            return ValueTraits<uint64_t>::scale(value.raw, max.raw, len);
+        }
+        // Round the axis to 2 significant digits of the highest value (at least one unit of the last place).
+        static Decimal unit(Decimal max) {
+            uint64_t step{1};
+            while (max.raw / step >= 100) {
+                step *= 10;
+            }
+            return Decimal{step};
+        }
+        static Decimal round_down(Decimal value, Decimal unit) {
+            return Decimal{(value.raw / unit.raw) * unit.raw};
+        }
+        static Decimal add(Decimal a, Decimal b) {
+            return Decimal{ValueTraits<uint64_t>::add(a.raw, b.raw)};
+        }
+        static bool positive(Decimal value) {
+            return value.raw > 0;
+        }
+        static std::string to_string(Decimal value) {
+            std::string str = std::to_string(value.raw / Decimal::SCALE);
+            uint64_t frac = value.raw % Decimal::SCALE;
+            if (frac > 0) {
+                std::string digits = std::to_string(frac + Decimal::SCALE).substr(1);
+                digits.erase(digits.find_last_not_of('0') + 1);
+                str += "." + digits;
+            }
+            return str;
+        }
+        static std::string to_short_string(Decimal value) {
+            if (value.raw < 1000 * Decimal::SCALE) {
+                return to_string(value);
+            }
+            return short_number(static_cast<double>(value.raw) / Decimal::SCALE);
+        }
+    };
+
+    //* The type of the values, chosen when compiling (see BCR_VALUE_TYPE in CMakeLists.txt).
+#if defined(BCR_VALUE_DOUBLE)
+    using value_t = double;
+#elif defined(BCR_VALUE_DECIMAL)
+    using value_t = Decimal;
+#else
+    using value_t = uint64_t;
+#endif
+}
+
+#endif
@@ -42,11 +42,80 @@ namespace Color {
         31, 32, 33, 34, 35, 36, 37,
         91, 92, 93, 94, 95, 96, 97};
 
+    //=== Escape sequences built at compile time.
+    // An escape sequence "\e[<modifier>;<color>m" and its length.
+    struct Escape {
+        char text[8]{};
+        size_t len{0};
+    };
+
+    static constexpr char RESET[]{ "\e[0m" };
+    static constexpr size_t RESET_LEN{ sizeof(RESET) - 1 };
+
+    // The modifiers (0-7) and colors (30-37 and 90-97) in the table.
+    static constexpr size_t N_MODIFIERS{ 8 };
+    static constexpr size_t N_COLORS{ 16 };
+
+    constexpr bool in_table( short color, short modifier )
+    {
+        return modifier >= 0 and modifier < short(N_MODIFIERS)
+            and ((color >= 30 and color <= 37) or (color >= 90 and color <= 97));
+    }
+
+    constexpr size_t color_index( short color )
+    {
+        return color >= 90 ? size_t(color - 90 + 8) : size_t(color - 30);
+    }
+
+    constexpr Escape make_escape( short color, short modifier )
+    {
+        Escape e;
+        e.text[e.len++] = '\e';
+        e.text[e.len++] = '[';
+        e.text[e.len++] = char('0' + modifier);
+        e.text[e.len++] = ';';
+        e.text[e.len++] = char('0' + color / 10);
+        e.text[e.len++] = char('0' + color % 10);
+        e.text[e.len++] = 'm';
+        return e;
+    }
+
+    constexpr array< array< Escape, N_COLORS >, N_MODIFIERS > make_escape_table()
+    {
+        array< array< Escape, N_COLORS >, N_MODIFIERS > table{};
+        for ( size_t m{0}; m < N_MODIFIERS; m++ ) {
+            for ( size_t c{0}; c < N_COLORS; c++ ) {
+                short color = short(c < 8 ? 30 + c : 90 + c - 8);
+                table[m][c] = make_escape( color, short(m) );
+            }
+        }
+        return table;
+    }
+
+    static constexpr auto escape_table{ make_escape_table() };
+
+    // The escape sequence of a color, taken from the table.
+    constexpr const Escape & escape( short color, short modifier )
+    {
+        return escape_table[modifier][color_index(color)];
+    }
+
     inline string tcolor( const string & msg, short color=Color::WHITE, short modifier=Color::REGULAR )
     {
-        ostringstream oss;
-        oss << "\e[" << modifier << ";" << color << "m" << msg << "\e[0m";
-        return oss.str();
+        string res;
+        if ( in_table( color, modifier ) ) {
+            const Escape & e = escape( color, modifier );
+            res.reserve( e.len + msg.size() + RESET_LEN );
+            res.append( e.text, e.len );
+        }
+        else {
+            // Colors out of the table are formatted as before.
+            ostringstream oss;
+            oss << "\e[" << modifier << ";" << color << "m";
+            res = oss.str();
+        }
+        res.append( msg ).append( RESET, RESET_LEN );
+        return res;
     }
 }
 #endif
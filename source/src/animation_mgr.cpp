@@ -15,6 +15,9 @@
  * @namespace bcr contains all the classes used in the bar chart race.
  */
 namespace bcr {
+    //* Moves the cursor home and clears the screen and its scroll back (as the clear command does).
+    static constexpr char CLEAR_SCREEN[]{"\e[H\e[2J\e[3J"};
+
     //============[ AnimationManager METHODS ]===============//
 
     void AnimationManager::usage(std::string error) {
@@ -24,13 +27,29 @@ namespace bcr {
         // Print the guide to run the program correctly.
         std::cerr << "\nUsage: " << Color::tcolor("$ ", Color::BRIGHT_GREEN, Color::REGULAR);
         std::cerr << Color::tcolor(opt.exe_filename, Color::BRIGHT_GREEN, Color::REGULAR);
-        std::cerr << Color::tcolor(" [<options>] <input_data_file>\n", Color::BRIGHT_GREEN, Color::REGULAR);
+        std::cerr << Color::tcolor(" [<options>] <input_data_file> [<input_data_file>...]\n", Color::BRIGHT_GREEN, Color::REGULAR);
+        std::cerr << "  With many data files, the races are shown side by side, in a grid, sharing a timeline\n";
+        std::cerr << "  (a race moves when the other ones reach the time stamp of its next chart).\n";
         std::cerr << "  Bar Chart Race options:\n";
         std::cerr << "    -h  Print this help text.\n";
         std::cerr << "    -b  <num> Max # of bars in a single char.\n";
         std::cerr << "                Valid range is [1,15]. Default values is 5.\n";
         std::cerr << "    -f  <num> Animation speed in fps (frames per second).\n";
         std::cerr << "                Valid range is [1,24]. Default value is 24.\n";
+        std::cerr << "    -c  <depth> Colors of the categories: 16, 256 or truecolor.\n";
+        std::cerr << "                Default is 16 up to 14 categories, 256 (or truecolor) above it.\n";
+        std::cerr << "    -w  <num> Length of the largest bar: 30, 45, 60, 90 or 120.\n";
+        std::cerr << "                Default value is 45 (the chart is twice as wide).\n";
+        std::cerr << "    --io <mode> How to read the data file: mmap (default) or pread (reader threads).\n";
+        std::cerr << "    --validate  Only check the data file and print out every issue found,\n";
+        std::cerr << "                one per line: <line> <byte offset> <code> <message>.\n";
+        std::cerr << "    --skip-bad  Skip the corrupt charts of the data file instead of stopping.\n";
+        std::cerr << "    --headless  Don't wait for enter nor the fps, and print out the load and render\n";
+        std::cerr << "                times at the end (to measure the program, with stdout redirected).\n";
+        std::cerr << "    --overtakes Mark the bars that went up in the ranking since the last chart (▲ and the places).\n";
+        std::cerr << "    --no-cache  Don't read nor write the layout cache (<input_data_file>.layout).\n";
+        std::cerr << "    --record <file> Record the frames to an asciicast (v2) file, with the timing of the fps.\n";
+        std::cerr << "    --play <file>   Play a recording back, instead of a race (no data file is needed).\n";
         exit(1);
     }
 
@@ -41,262 +60,375 @@ namespace bcr {
         std::cout << "===================================================\n\n";
     }
     
-    void AnimationManager::read_input_file(std::string file_name) {
-        std::cout << Color::tcolor(">>> Preparing to read input file \"", Color::YELLOW, Color::REGULAR);
-        std::cout << Color::tcolor(file_name, Color::YELLOW, Color::REGULAR);
-        std::cout << Color::tcolor("\"...\n", Color::YELLOW, Color::REGULAR);
+    bool AnimationManager::read_input_file(Race &race, std::ostream &out) {
+        const std::string &file_name = race.data_filename;
+        out << Color::tcolor(">>> Preparing to read input file \"", Color::YELLOW, Color::REGULAR);
+        out << Color::tcolor(file_name, Color::YELLOW, Color::REGULAR);
+        out << Color::tcolor("\"...\n", Color::YELLOW, Color::REGULAR);
         
-        std::string line;
-        std::ifstream data_file;
-        data_file.open(file_name);
+        auto start = std::chrono::steady_clock::now();
+        std::string open_err;
+        std::unique_ptr<InputSource> data_file = InputSource::open(file_name, opt.io_mode, open_err);
 
-        std::cout << Color::tcolor("\n>>> Processing data, please wait.", Color::YELLOW, Color::REGULAR) << std::flush;
+        out << Color::tcolor("\n>>> Processing data, please wait.", Color::YELLOW, Color::REGULAR) << std::flush;
         
-        if (not data_file.is_open()) {
-            std::string err("\n>>> ERROR! We didn't can found/open the file. This file probably doesn't exist.");
-            usage(err);
+        if (data_file == nullptr) {
+            std::string err("\n>>> ERROR! We didn't can found/open the file (" + open_err + ").");
+            race.error = err;
+            return false;
         }
+        LineReader lines(*data_file);
+        std::string_view line;
         
         //* [1] Read the file header to get the title, the category label, and source information.
-        std::getline(data_file, line);
-        if (data_file.fail()) {
+        if (not lines.next(line)) {
             std::string err("\n>>> ERROR! We didn't can read the file. It isn't a data file.");
-            usage(err);
+            race.error = err;
+            return false;
         }
-        data_base.set_title(line);
-        std::getline(data_file, line);
-        if (data_file.fail()) {
+        race.data_base.set_title(std::string(line));
+        if (not lines.next(line)) {
             std::string err("\n>>> ERROR! We couldn't read the file correctly, the file is corrupt.");
-            usage(err);
+            race.error = err;
+            return false;
         }
-        data_base.set_label(line);
-        std::getline(data_file, line);
-        if (data_file.fail()) {
+        race.data_base.set_label(std::string(line));
+        if (not lines.next(line)) {
             std::string err("\n>>> ERROR! We couldn't read the file correctly, the file is corrupt.");
-            usage(err);
+            race.error = err;
+            return false;
         }
-        data_base.set_source_info(line);
+        race.data_base.set_source_info(std::string(line));
 
         size_t n_bars;
-        std::string arg;
-        std::stringstream tokenizer;
+        size_t line_no{3}; ///< The number of the last line read.
+        bool reuse_line{false}; ///< If the last line read is the header of the next block.
+        DataValidator::RecordFields fields;
         //* [2] Read the Bar Charts. While there is line to read.
-        while (not data_file.eof()) {
-            std::getline(data_file, line);
-            tokenizer.clear();
-            tokenizer << line;
+        while (reuse_line or lines.next(line)) {
+            if (not reuse_line) {
+                line_no++;
+            }
+            reuse_line = false;
             // [2.1] Read a single integer n_bars: the total number of bars for the current bar chart.
-            if (tokenizer >> n_bars) {
-                // [2.2] Instantiate an empty BarChart object with smart pointer.
-                std::shared_ptr<BarChart> bc {new BarChart()};
-                // [2.3] Fixed loop to read n_bars lines from the input file.
-                std::string time, dummy;
-                std::vector<BarChart::BarItem> bis(n_bars);
-                for (size_t i{0}; i < n_bars; i++) {
-                    std::getline(data_file, line); //< time_stamp, label, other_related_info, value, category
-                    if (data_file.fail()) {
-                        std::string err("\n>>> ERROR! We couldn't read the file correctly, the file is corrupt.");
-                        usage(err);
-                    }
-                    std::stringstream ss(line);
-                    // time_stamp
-                    std::getline(ss, arg, ',');
-                    if (ss.fail()) {
-                        std::string err("\n>>> ERROR! We couldn't read the file correctly, the file is corrupt.");
-                        usage(err);
-                    }
-                    tokenizer.clear();
-                    time = arg;
-                    // label
-                    std::getline(ss, arg, ',');
-                    if (ss.fail()) {
-                        std::string err("\n>>> ERROR! We couldn't read the file correctly, the file is corrupt.");
-                        usage(err);
+            if (not DataValidator::parse_block_header(line, n_bars)) {
+                // Blank lines separate the blocks, anything else is out of place.
+                if (DataValidator::is_blank(line) or opt.skip_bad) {
+                    continue;
+                }
+                std::string err("\n>>> ERROR! We couldn't read the file correctly, the file is corrupt (line "
+                    + std::to_string(line_no) + ": expected the number of bars of a chart).");
+                race.error = err;
+                return false;
+            }
+            // [2.2] Instantiate an empty BarChart object with smart pointer.
+            std::shared_ptr<BarChart> bc {new BarChart()};
+            // [2.3] Fixed loop to read n_bars lines from the input file.
+            std::string time;
+            std::vector<BarChart::BarItem> bis;
+            bool bad_block{n_bars == 0};
+            bis.reserve(std::min<size_t>(n_bars, 1024));
+            for (size_t i{0}; i < n_bars; i++) {
+                //< time_stamp, label, other_related_info, value, category
+                if (not lines.next(line)) {
+                    if (not opt.skip_bad and not data_file->failed()) {
+                        std::string err("\n>>> ERROR! We couldn't read the file correctly, the file is corrupt (line "
+                            + std::to_string(line_no) + ": the file ends before the last chart is complete).");
+                        race.error = err;
+                        return false;
                     }
-                    tokenizer.clear();
-                    bis[i].label = arg;
-                    // other_related_info/dummy
-                    std::getline(ss, arg, ',');
-                    if (ss.fail()) {
-                        std::string err("\n>>> ERROR! We couldn't read the file correctly, the file is corrupt.");
-                        usage(err);
+                    bad_block = true;
+                    break;
+                }
+                line_no++;
+                BarChart::BarItem bi;
+                const std::vector<uint32_t> &commas = lines.get_commas();
+                auto code = DataValidator::parse_record(line, commas.data(), commas.size(), fields, bi.value);
+                if (code != DataValidator::NONE) {
+                    if (not opt.skip_bad) {
+                        std::string err("\n>>> ERROR! We couldn't read the file correctly, the file is corrupt (line "
+                            + std::to_string(line_no) + ": " + DataValidator::code_name(code) + ").");
+                        race.error = err;
+                        return false;
                     }
-                    tokenizer.clear();
-                    dummy = arg;
-                    // value
-                    std::getline(ss, arg, ',');
-                    if (ss.fail()) {
-                        std::string err("\n>>> ERROR! We couldn't read the file correctly, the file is corrupt.");
-                        usage(err);
+                    bad_block = true;
+                    // The chart is shorter than declared: go on from the blank line or the next header.
+                    size_t next_n_bars;
+                    if (DataValidator::parse_block_header(line, next_n_bars)) {
+                        reuse_line = true;
+                        break;
                     }
-                    tokenizer.clear();
-                    tokenizer << arg;
-                    tokenizer >> bis[i].value;
-                    // category
-                    std::getline(ss, arg, '\n');
-                    if (ss.fail()) {
-                        std::string err("\n>>> ERROR! We couldn't read the file correctly, the file is corrupt.");
-                        usage(err);
+                    if (DataValidator::is_blank(line)) {
+                        break;
                     }
-                    tokenizer.clear();
-                    bis[i].category = arg;
-                    // Try to insert a new category in a std::set.
-                    cat.insert(bis[i].category);
-                    ss.clear();
+                    continue;
                 }
-                // [2.4] Store the time_stamp of the last bar as the overall bc's time stamp.
-                // And store the n_bars as the number of bars of the bar chart.
-                bc->set_timestamp(time);
-                // [2.5] Sort the bars of bc object, from highest bar value to the lowest bar value.
-                std::vector<BarChart::BarItem> bc_sorted = sort_bc(bis);
-                for (size_t i{0}; i < n_bars; i++) {
-                    bc->add_new_bar(bc_sorted[i]);
+                time = fields.time;
+                bi.label = std::string(fields.label);
+                bi.category = race.data_base.add_category(fields.category);
+                bis.push_back(std::move(bi));
+            }
+            if (bad_block) {
+                if (data_file->failed()) {
+                    // Reported below.
+                    break;
+                }
+                if (not opt.skip_bad) {
+                    std::string err("\n>>> ERROR! We couldn't read the file correctly, the file is corrupt (line "
+                        + std::to_string(line_no) + ": a chart without bars).");
+                    race.error = err;
+                    return false;
                 }
-                // [2.6] Store the current (sorted) bc object into the Database object.
-                data_base.add_new_barchart(bc);
+                race.n_skipped_blocks++;
+                continue;
             }
-        }
-        //* [3] Instantiate a map with category and its color.
-        //* If the number of categories is less than or equal to 14.
-        if (cat.size() <= 14) {
-            for (size_t i{0}; i < cat.size(); i++) {
-                auto str_cat = *next(cat.begin(), i);
-                cat_color[str_cat] = Color::color_list[i];
+            // [2.4] Store the time_stamp of the last bar as the overall bc's time stamp.
+            // And store the n_bars as the number of bars of the bar chart.
+            bc->set_timestamp(time);
+            // [2.5] Sort the bars of bc object, from highest bar value to the lowest bar value,
+            // starting from the order of the previous chart.
+            race.ranker.rank(bis);
+            for (size_t i{0}; i < n_bars; i++) {
+                bc->add_new_bar(bis[i]);
             }
+            // [2.6] Store the current (sorted) bc object into the Database object.
+            race.data_base.add_new_barchart(bc);
         }
-        data_file.close();
-        std::cout << Color::tcolor("\n>>> Input file sucessfuly read.\n", Color::GREEN, Color::BOLD);
+        if (data_file->failed()) {
+            std::string err("\n>>> ERROR! We couldn't read the file, there was an input/output or decompression error.");
+            race.error = err;
+            return false;
+        }
+        race.io_stats = data_file->get_stats();
+        race.io_compression = data_file->get_compression();
+        race.load_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+        out << Color::tcolor("\n>>> Input file sucessfuly read.\n", Color::GREEN, Color::BOLD);
+        return true;
     }
 
-    void AnimationManager::summary(void) {
+    void AnimationManager::validate_file(std::string file_name) {
+        DataValidator validator;
+        bool valid = validator.validate(file_name);
+        // The report goes to the standard output, so it may be piped to other programs.
+        validator.report(std::cout);
         std::ostringstream oss;
-        oss << "\n>>> We have \"" << data_base.get_n_charts() << "\" charts"
+        oss << ">>> " << validator.get_n_lines() << " lines and " << validator.get_n_blocks() << " charts checked, "
+            << validator.get_issues().size() << " issues found in " << validator.get_n_bad_blocks() << " charts.\n";
+        if (valid) {
+            std::cerr << Color::tcolor(oss.str(), Color::GREEN, Color::BOLD);
+        }
+        else {
+            std::cerr << Color::tcolor(oss.str(), Color::RED, Color::BOLD);
+            exit_status = EXIT_FAILURE;
+        }
+    }
+
+    void AnimationManager::summary(const Race &race) {
+        const FrameLayout &layout = race.layout;
+        std::ostringstream oss;
+        if (races.size() > 1) {
+            oss << "\n>>> Race: " << race.data_filename;
+        }
+        oss << "\n>>> We have \"" << layout.get_n_frames() << "\" charts"
             << ", each with a maximum of \"" << opt.n_bars << "\" bars.\n"
             << "\n>>> Animation speed is: " << opt.fps << ".\n"
-            << ">>> Title: " << data_base.get_title() << "\n"
-            << ">>> Value is: " << data_base.get_label() << "\n"
-            << ">>> Source: " << data_base.get_source_info() << "\n"
-            << ">>> # of categories found: " << cat.size() << "\n";
+            << ">>> Title: " << layout.get_title() << "\n"
+            << ">>> Value is: " << layout.get_label() << "\n"
+            << ">>> Source: " << layout.get_source_info() << "\n"
+            << ">>> # of categories found: " << layout.get_n_categories() << "\n"
+            << ">>> Colors: " << ColorTable::depth_name(race.colors.get_depth()) << "\n";
+        if (opt.skip_bad) {
+            oss << ">>> # of corrupt charts skipped: " << layout.get_n_skipped() << "\n";
+        }
+        // How much of the reading was spent waiting for the disk (only when the data file was read).
+        if (race.load_ns > 0) {
+            const IoStats &io_stats = race.io_stats;
+            oss << std::fixed << std::setprecision(1)
+                << ">>> Read " << io_stats.bytes / 1e6 << " MB";
+            if (io_stats.compressed_bytes > 0) {
+                oss << " (" << io_stats.compressed_bytes / 1e6 << " MB " << InputSource::compression_name(race.io_compression) << ")";
+            }
+            oss << " in " << race.load_ns / 1e6 << " ms ("
+                << InputSource::mode_name(io_stats.mapped ? InputSource::MMAP : InputSource::PREAD) << "), I/O wait: "
+                << 100.0 * io_stats.wait_ns / race.load_ns << "%, major page faults: " << io_stats.major_faults
+                << ", lines indexed with " << StructIndexer::isa_name(StructIndexer::best()) << "\n";
+            oss << ">>> Ranking: " << race.ranker.get_n_repaired() << " charts repaired from the previous one ("
+                << race.ranker.get_n_overtakes() << " overtakes), " << race.ranker.get_n_resorted() << " sorted from scratch\n";
+        }
         std::cout << Color::tcolor(oss.str(), Color::YELLOW, Color::REGULAR);
     }
 
-    std::ostringstream AnimationManager::get_axis(size_t n_bars, std::vector<BarChart::BarItem> bis) const {
-        std::ostringstream oss;
-        size_t last{n_bars - 1}; ///< The last bar that will be printed (lower value).
-        size_t low_value = (bis[last].value / 10) * 10; ///< The minimum value (after 0) that will be represented in the bar (rounds down).
-        size_t high_value = ((bis[0].value / 10) * 10) + 10; ///< The maximum value that will be represented in the bar (rounds up).
-        size_t aux_value{low_value}; ///< The smaller value that will be jumped.
-        size_t aux_pos_1, aux_pos_2, jumps;
-        size_t increment = (high_value - low_value) / 5; ///< The increment of the value in each position in the axis.
-        
-        // If the bar value with the max value is bigger than 0.
-        if (bis[0].value > 0) {
-            size_t low_pos = (low_value * MAX_BAR_LEN) / bis[0].value; ///< The position of the smallest value proportional to the size of the largest bar.
-            //* Set - and +
-            oss << "+";
-            // Display the range (0, min_value]
-            if (low_value > 0) {
-                for (size_t i{1}; i < low_pos-1; i++) {
-                    oss << "-";
-                }
-                oss << "+";
+    bool AnimationManager::load_layout(Race &race, std::ostream &out) {
+        FrameLayout &layout = race.layout;
+        std::string cache_name = race.data_filename + ".layout";
+        FrameLayout::Key key;
+        bool has_key = FrameLayout::make_key(race.data_filename, opt.n_bars, opt.bar_len, opt.skip_bad, key);
+        //* [1] Use the layout of the last run, if the data file and the options are the same.
+        if (opt.use_cache and has_key and layout.load(cache_name, key)) {
+            out << Color::tcolor(">>> Layout of the charts read from \"", Color::YELLOW, Color::REGULAR);
+            out << Color::tcolor(cache_name, Color::YELLOW, Color::REGULAR);
+            out << Color::tcolor("\".\n", Color::YELLOW, Color::REGULAR);
+        }
+        //* [2] Otherwise read the data file and compute the layout of every chart once.
+        else {
+            if (not read_input_file(race, out)) {
+                return false;
             }
-            // Print the 5 '+'.
-            for (size_t i{0}; i < 5; i++) {
-                aux_value += increment;
-                aux_pos_1 = (aux_value * MAX_BAR_LEN) / bis[0].value;
-                aux_pos_2 = ((aux_value - increment) * MAX_BAR_LEN) / bis[0].value;
-                if (aux_pos_1 - aux_pos_2 == 0)
-                    jumps = 0;
-                else
-                    jumps = aux_pos_1 - aux_pos_2 - 1;
-                // Print (less_value, bigger_value]
-                for (size_t j{0}; j < jumps; j++) {
-                    oss << "-";
-                }
-                oss << "+";
+            layout.build(race.data_base, opt.n_bars, opt.bar_len, race.n_skipped_blocks);
+            // The cache is only a shortcut, it's fine if it can't be written.
+            if (opt.use_cache and has_key) {
+                layout.save(cache_name, key);
             }
-            // Print the rest of the axis.
-            oss << std::setfill('-') << std::setw(MAX_BAR_LEN * 2 - aux_pos_1) << ">" << "\n";
-            oss << std::setfill(' ');
-            //* Set numbers
-            aux_value = low_value;
-            // Display the first position (0)
-            if (low_value > 0) {
-                oss << "0";
+        }
+        return true;
+    }
+
+    void AnimationManager::assign_colors(Race &race, const std::vector<std::string> &shared) {
+        //* Give a color to each category and build the color legend, wrapping its lines.
+        const FrameLayout &layout = race.layout;
+        ColorTable &colors = race.colors;
+        std::string &legend = race.legend;
+        colors.assign(layout.get_categories(), opt.color_depth, shared);
+        legend.clear();
+        size_t line_len{0};
+        for (const auto &entry : layout.get_legend()) {
+            std::string name(layout.text(entry.text, entry.len));
+            size_t entry_len = name.size() + 4; ///< "█: " and the space after the name.
+            if (line_len > 0 and line_len + entry_len > opt.bar_len*2) {
+                legend += "\n";
+                line_len = 0;
             }
-            oss << std::setw(low_pos) << aux_value;
-            for (size_t i{0}; i < 5; i++) {
-                aux_value += increment;
-                aux_pos_1 = (aux_value * MAX_BAR_LEN) / bis[0].value;
-                aux_pos_2 = ((aux_value - increment) * MAX_BAR_LEN) / bis[0].value;
-                if (aux_pos_1 - aux_pos_2 == 0)
-                    jumps = 0;
-                else
-                    jumps = aux_pos_1 - aux_pos_2 - 1;
-                oss << std::setw(jumps+1) << aux_value;
+            legend += colors.tcolor("█", entry.category, false) + ": " + colors.tcolor(name, entry.category, true) + " ";
+            line_len += entry_len;
+        }
+        race.renderer = FrameRenderer::create(opt.bar_len, colors, layout.get_n_categories(), legend, opt.overtakes);
+    }
+
+    void AnimationManager::load_races(void) {
+        auto start = std::chrono::steady_clock::now();
+        races.resize(opt.data_filenames.size());
+        for (size_t i{0}; i < races.size(); i++) {
+            races[i].data_filename = opt.data_filenames[i];
+        }
+        //* [1] A single race prints out its progress as it goes.
+        if (races.size() == 1) {
+            if (not load_layout(races[0], std::cout)) {
+                usage(races[0].error);
             }
-            oss << "\n";
         }
+        //* [2] Many races are read in parallel, and their messages printed out in order at the end.
+        // A race that fails doesn't stop the other ones: its error is printed out once all of them end.
         else {
-            oss << "+>\n" << "0";
+            std::vector<std::ostringstream> logs(races.size());
+            std::vector<std::thread> loaders;
+            for (size_t i{0}; i < races.size(); i++) {
+                loaders.emplace_back([this, i, &logs]() { load_layout(races[i], logs[i]); });
+            }
+            for (auto &loader : loaders) {
+                loader.join();
+            }
+            for (size_t i{0}; i < races.size(); i++) {
+                std::cout << logs[i].str() << "\n";
+            }
+            for (const auto &race : races) {
+                if (not race.error.empty()) {
+                    usage(race.error);
+                }
+            }
+        }
+        //* [3] The races share the colors, so a category has the same color in all of them.
+        std::vector<std::string> all_categories;
+        if (races.size() > 1) {
+            for (const auto &race : races) {
+                std::vector<std::string> categories = race.layout.get_categories();
+                all_categories.insert(all_categories.end(), categories.begin(), categories.end());
+            }
         }
-        oss << Color::tcolor(data_base.get_label(), Color::YELLOW, Color::BOLD);
+        for (auto &race : races) {
+            assign_colors(race, all_categories);
+        }
+        compositor = FrameCompositor(FrameCompositor::columns_for(races.size()), opt.bar_len * 2 + 2);
+        //* [4] Create the recording, titled after the races.
+        if (not opt.record_filename.empty()) {
+            std::string title;
+            for (const auto &race : races) {
+                title += (title.empty() ? "" : " | ") + std::string(race.layout.get_title());
+            }
+            if (not recorder.open(opt.record_filename, title)) {
+                std::string err("\n>>> ERROR! We couldn't create the recording file \"" + opt.record_filename + "\".");
+                usage(err);
+            }
+        }
+        layout_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+    }
 
-        return oss;
+    bool AnimationManager::next_tick(void) {
+        auto next_of = [](const Race &race) { return race.started ? race.frame + 1 : 0; };
+        //* [1] The earliest time stamp among the next chart of each race.
+        bool found{false};
+        std::string_view time;
+        for (const auto &race : races) {
+            if (next_of(race) < race.layout.get_n_frames()) {
+                std::string_view next = race.layout.get_time(next_of(race));
+                if (not found or DataValidator::compare_timestamps(next, time) < 0) {
+                    time = next;
+                    found = true;
+                }
+            }
+        }
+        if (not found) {
+            return false;
+        }
+        //* [2] The races with a chart at that time move to it, the other ones keep their chart.
+        for (auto &race : races) {
+            size_t next = next_of(race);
+            if (next < race.layout.get_n_frames()
+                and DataValidator::compare_timestamps(race.layout.get_time(next), time) == 0) {
+                race.frame = next;
+                race.started = true;
+            }
+        }
+        return true;
     }
-    
+
     void AnimationManager::display_bc(void) {
-        std::shared_ptr<BarChart> bc = data_base.get_chart();
-        std::vector<BarChart::BarItem> bis = bc->get_bars();
-        std::ostringstream oss;
-        size_t n_bars;
-        // Display the titles.
-        size_t len_main_title = (MAX_BAR_LEN*2 - data_base.get_title().size())/2;
-        size_t len_timestamp = (MAX_BAR_LEN*2 - bc->get_timestamp().size())/2;
-        oss << std::setw(len_main_title) << "" << data_base.get_title() << "\n\n";
-        oss << std::setw(len_timestamp) << "" << bc->get_timestamp() << "\n\n";
-        std::cout << Color::tcolor(oss.str(), Color::BLUE, Color::BOLD);
-        oss.clear();
-        // Display the bars.
-        if (bc->get_n_bars() < opt.n_bars) {
-            n_bars = bc->get_n_bars();
+        frame_text.clear();
+        // The terminal is cleared with escape sequences, in the same write as the frame.
+        if (not opt.headless) {
+            frame_text.append(CLEAR_SCREEN);
+        }
+        if (races.size() == 1) {
+            races[0].renderer->render(races[0].layout, races[0].frame, frame_text);
         }
         else {
-            n_bars = opt.n_bars;
-        }
-        for (size_t i{0}; i < n_bars; i++) {
-            if (bis[i].value > 0) {
-                size_t bar_len = (bis[i].value * MAX_BAR_LEN) / bis[0].value;
-                for (size_t j{0}; j < bar_len; j++) {
-                    if (cat.size() <= 14)
-                        std::cout << Color::tcolor("█", cat_color[bis[i].category], Color::REGULAR);
-                    else
-                        std::cout << Color::tcolor("█", Color::WHITE, Color::REGULAR);
+            cells.clear();
+            for (auto &race : races) {
+                race.frame_text.clear();
+                if (race.started) {
+                    race.renderer->render(race.layout, race.frame, race.frame_text);
                 }
+                else {
+                    race.renderer->render_waiting(race.layout, race.frame_text);
+                }
+                cells.push_back(race.frame_text);
             }
-            if (cat.size() <= 14)
-                std::cout << " " << Color::tcolor(bis[i].label, cat_color[bis[i].category], Color::BOLD) << " [" << bis[i].value << "]\n\n";
-            else
-                std::cout << " " << Color::tcolor(bis[i].label, Color::WHITE, Color::BOLD) << " [" << bis[i].value << "]\n\n";
-            oss.clear();
-        }
-        // Display x axis.
-        oss = get_axis(n_bars, bis);
-        std::cout << oss.str();
-        oss.clear();
-        // Display source info.
-        std::cout << "\n\n" << Color::tcolor(data_base.get_source_info(), Color::WHITE, Color::BOLD);
-        // Display legend.
-        if (cat.size() <= 14) {
-            std::cout << "\n";
-            std::map<std::string, Color::value_t>::iterator it;
-            for (it=cat_color.begin(); it!=cat_color.end(); ++it) {
-                std::cout << Color::tcolor("█", it->second, Color::REGULAR) << ": "
-                    << Color::tcolor(it->first, it->second, Color::BOLD) << " ";
-            }
+            compositor.compose(cells, frame_text);
+        }
+        std::cout.write(frame_text.data(), frame_text.size()) << std::flush;
+        // The recording has the frames as they are, at the times the fps gives.
+        if (recorder.is_open()) {
+            size_t clear_len = opt.headless ? 0 : sizeof(CLEAR_SCREEN) - 1;
+            recorder.add_frame(std::string_view(frame_text).substr(clear_len), static_cast<double>(n_rendered) / opt.fps);
+        }
+    }
+
+    void AnimationManager::play_recording(void) {
+        CastPlayer player;
+        std::string err;
+        if (not player.play(opt.play_filename, not opt.headless, err)) {
+            std::string msg("\n>>> ERROR! We couldn't play the recording \"" + opt.play_filename + "\" (" + err + ").");
+            usage(msg);
         }
-        std::cout << "\n\n";
     }
 
     void AnimationManager::initialize(int argc, char *argv[]) {
@@ -367,13 +499,89 @@ namespace bcr {
                     }
                     i++;
                 }
+                // Check if the argument is the color depth.
+                else if (str == "-c" and has_arguments) {
+                    std::string str_value(argv[i+1]);
+                    for (size_t j{0}; j < str_value.length(); j++) {
+                        str_value[j] = tolower(str_value[j]);
+                    }
+                    if (not ColorTable::parse_depth(str_value, opt.color_depth)) {
+                        std::string err("\n>>> ERROR! The color depth you entered is invalid (use 16, 256 or truecolor).");
+                        usage(err);
+                    }
+                    i++;
+                }
+                // Check if the argument is the length of the largest bar.
+                else if (str == "-w" and has_arguments) {
+                    try {
+                        opt.bar_len = std::stoul(argv[i+1]);
+                    }
+                    catch(const std::exception& e) {
+                        std::string err("\n>>> ERROR! The bar length you entered is invalid (invalid argument).");
+                        usage(err);
+                    }
+                    if (not FrameRenderer::supported(opt.bar_len)) {
+                        std::string err("\n>>> ERROR! The bar length you entered is not 30, 45, 60, 90 or 120.");
+                        usage(err);
+                    }
+                    i++;
+                }
+                // Check if the argument is the way of reading the data file.
+                else if (str == "--io" and has_arguments) {
+                    std::string str_value(argv[i+1]);
+                    for (size_t j{0}; j < str_value.length(); j++) {
+                        str_value[j] = tolower(str_value[j]);
+                    }
+                    if (str_value == "mmap") {
+                        opt.io_mode = InputSource::MMAP;
+                    }
+                    else if (str_value == "pread") {
+                        opt.io_mode = InputSource::PREAD;
+                    }
+                    else {
+                        std::string err("\n>>> ERROR! The input mode you entered is invalid (use mmap or pread).");
+                        usage(err);
+                    }
+                    i++;
+                }
                 // Check if the argument is help.
                 else if (str == "-h") {
                     usage("");
                 }
+                // Check if the argument is the validation mode.
+                else if (str == "--validate") {
+                    opt.validate = true;
+                }
+                // Check if the argument is to skip the corrupt charts.
+                else if (str == "--skip-bad") {
+                    opt.skip_bad = true;
+                }
+                // Check if the argument is the headless mode.
+                else if (str == "--headless") {
+                    opt.headless = true;
+                }
+                // Check if the argument is to mark the overtakes.
+                else if (str == "--overtakes") {
+                    opt.overtakes = true;
+                }
+                // Check if the argument is to ignore the layout cache.
+                else if (str == "--no-cache") {
+                    opt.use_cache = false;
+                }
+                // Check if the argument is the recording file.
+                else if (str == "--record" and has_arguments) {
+                    opt.record_filename = argv[i+1];
+                    i++;
+                }
+                // Check if the argument is a recording to play.
+                else if (str == "--play" and has_arguments) {
+                    opt.play_filename = argv[i+1];
+                    passed_df = true;
+                    i++;
+                }
                 // Check if the argument is the name of the data file.
                 else {
-                    opt.data_filename = argv[i];
+                    opt.data_filenames.push_back(argv[i]);
                     passed_df = true;
                 }
             }
@@ -395,12 +603,26 @@ namespace bcr {
         return app_state == AppState::END;
     }
 
+    int AnimationManager::get_exit_status(void) const {
+        return exit_status;
+    }
+
     void AnimationManager::process_event(void) {
-        if (app_state == AppState::WELCOME) {
-            // Calls the function that reads the input file.
-            read_input_file(opt.data_filename);
+        if (app_state == AppState::VALIDATING) {
+            // Checks each input file, without animating it.
+            for (const auto &file_name : opt.data_filenames) {
+                validate_file(file_name);
+            }
         }
-        else if (app_state == AppState::READING) {
+        else if (app_state == AppState::PLAYING) {
+            // Writes the frames of the recording, as they were recorded.
+            play_recording();
+        }
+        else if (app_state == AppState::WELCOME) {
+            // Calls the function that reads the input files (or their layout caches).
+            load_races();
+        }
+        else if (app_state == AppState::READING and not opt.headless) {
             // Waits for the user to press enter to start the animation.
             std::string enter{""};
             do {
@@ -408,7 +630,7 @@ namespace bcr {
                 std::getline(std::cin, enter);
             } while (enter.length() != 0);
         }
-        else if (app_state == AppState::RACING) {
+        else if (app_state == AppState::RACING and not opt.headless) {
             // Pause the execution for a few milliseconds to simulate the animation speed requested by the user in the fps input option.
             std::chrono::milliseconds duration{1000/opt.fps};
             std::this_thread::sleep_for(duration);
@@ -417,22 +639,29 @@ namespace bcr {
 
     void AnimationManager::update(void) {
         if (app_state == AppState::START) {
-            app_state = AppState::WELCOME;
+            if (opt.validate) {
+                app_state = AppState::VALIDATING;
+            }
+            else {
+                app_state = opt.play_filename.empty() ? AppState::WELCOME : AppState::PLAYING;
+            }
+        }
+        else if (app_state == AppState::VALIDATING or app_state == AppState::PLAYING) {
+            app_state = AppState::END;
         }
         else if (app_state == AppState::WELCOME) {
             app_state = AppState::READING;
         }
         else if (app_state == AppState::READING) {
-            app_state = AppState::RACING;
+            // Without charts there is nothing to animate.
+            bool has_charts = std::all_of(races.begin(), races.end(),
+                                          [](const Race &race) { return race.layout.get_n_frames() > 0; });
+            // The first tick starts the races with the earliest time stamp.
+            app_state = (has_charts and next_tick()) ? AppState::RACING : AppState::END;
         }
         else if (app_state == AppState::RACING) {
-            if (data_base.get_current_bc() + 1 < data_base.get_n_charts()) {
-                // Move though the database, feeding the bar chart with information that will be presented to the user.
-                std::size_t next_chart = data_base.get_current_bc() + 1;
-                data_base.set_current_bc(next_chart);
-            }
-            else {
-                // There aren't more bar chart, stop the animation.
+            // Move though the charts of the races, or stop the animation when there aren't more.
+            if (not next_tick()) {
                 app_state = AppState::END;
             }
         }
@@ -444,25 +673,41 @@ namespace bcr {
             welcome_message();
         }
         else if (app_state == AppState::READING) {
-            // Display a summary of information captured from the database.
-            summary();
+            // Display a summary of information captured from each database.
+            for (const auto &race : races) {
+                summary(race);
+            }
         }
         else if (app_state == AppState::RACING) {
-            // Display a single bar chart.
-            clear_screen();
+            // Display the current bar chart of each race.
+            auto start = std::chrono::steady_clock::now();
             display_bc();
+            render_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+            n_rendered++;
+        }
+        else if (app_state == AppState::END and recorder.is_open()) {
+            uint64_t n_events = recorder.get_n_events();
+            uint64_t frame_bytes = recorder.get_frame_bytes(), event_bytes = recorder.get_event_bytes();
+            std::ostringstream oss;
+            if (recorder.close()) {
+                oss << std::fixed << std::setprecision(1) << ">>> " << n_events << " frames recorded to \"" << opt.record_filename
+                    << "\" (" << event_bytes / 1e6 << " MB of output instead of " << frame_bytes / 1e6 << " MB, "
+                    << (frame_bytes > 0 ? 100.0 * event_bytes / frame_bytes : 0.0) << "%).\n";
+                std::cerr << Color::tcolor(oss.str(), Color::GREEN, Color::BOLD);
+            }
+            else {
+                oss << ">>> ERROR! We couldn't write the recording file \"" << opt.record_filename << "\".\n";
+                std::cerr << Color::tcolor(oss.str(), Color::RED, Color::BOLD);
+                exit_status = EXIT_FAILURE;
+            }
+        }
+        if (app_state == AppState::END and opt.headless and not opt.validate and opt.play_filename.empty()) {
+            // The times of the run, in a line easy to parse (see tools/scale_test.cpp).
+            std::ostringstream oss;
+            oss << std::fixed << std::setprecision(1) << ">>> Headless run: load_ms=" << layout_ns / 1e6
+                << " render_ms=" << render_ns / 1e6 << " frames=" << n_rendered << "\n";
+            std::cerr << oss.str();
         }
-    }
-    
-    void AnimationManager::clear_screen(){
-        //some C++ voodoo here ;D
-        #if defined _WIN32
-            system("cls");
-        #elif defined (LINUX) || defined(gnu_linux) || defined(linux)
-            system("clear");
-        #elif defined (APPLE)
-            system("clear");
-        #endif
     }
 
     //============[ End AnimationManager class ]===============//
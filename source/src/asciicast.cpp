@@ -0,0 +1,408 @@
+/*!
+ * @file asciicast.cpp
+ * @author João Guilherme Lopes Alves da Costa (joguicosta@hotmail.com)
+ * @brief Implementation of the asciicast recorder and player.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#include <algorithm> ///< To use max.
+#include <charconv> ///< To read the time of the events.
+#include <chrono> ///< To wait for the time of the events.
+#include <cstdio> ///< To use snprintf.
+#include <ctime> ///< To get the time of the recording.
+#include <iostream> ///< To flush cout before playing.
+#include <memory> ///< To use unique_ptr.
+#include <thread> ///< To use sleep_until.
+
+#include <unistd.h> ///< To use write.
+
+#include "../lib/text_color.h"
+#include "asciicast.h"
+#include "frame_compositor.h"
+#include "input_source.h"
+
+/*!
+ * @namespace bcr contains all the classes used in the bar chart race.
+ */
+namespace bcr {
+    /**
+     * @brief Append a text to a JSON string (escaping the quotes, backslashes and control characters).
+     */
+    static void append_json(std::string_view str, std::string &out) {
+        static constexpr char HEX[]{"0123456789abcdef"};
+        for (char c : str) {
+            switch (c) {
+                case '"': out += "\\\""; break;
+                case '\\': out += "\\\\"; break;
+                case '\n': out += "\\n"; break;
+                case '\r': out += "\\r"; break;
+                case '\t': out += "\\t"; break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20) {
+                        out += "\\u00";
+                        out += HEX[c >> 4];
+                        out += HEX[c & 0xF];
+                    }
+                    else {
+                        out += c;
+                    }
+            }
+        }
+    }
+
+    /**
+     * @brief Append the escape sequence that moves the cursor to a row and column (from 1).
+     */
+    static void append_goto(size_t row, size_t column, std::string &out) {
+        out += "\e[";
+        out += std::to_string(row);
+        out += ';';
+        out += std::to_string(column);
+        out += 'H';
+    }
+
+    /**
+     * @brief Append a character (code point) in UTF-8.
+     */
+    static void append_utf8(uint32_t code, std::string &out) {
+        if (code < 0x80) {
+            out += static_cast<char>(code);
+        }
+        else if (code < 0x800) {
+            out += static_cast<char>(0xC0 | (code >> 6));
+            out += static_cast<char>(0x80 | (code & 0x3F));
+        }
+        else if (code < 0x10000) {
+            out += static_cast<char>(0xE0 | (code >> 12));
+            out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (code & 0x3F));
+        }
+        else {
+            out += static_cast<char>(0xF0 | (code >> 18));
+            out += static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+            out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (code & 0x3F));
+        }
+    }
+
+    //============[ CastRecorder METHODS ]===============//
+
+    bool CastRecorder::open(const std::string &file_name, const std::string &title) {
+        file.open(file_name, std::ios::binary | std::ios::trunc);
+        if (not file.is_open()) {
+            return false;
+        }
+        this->title = title;
+        start_time = static_cast<int64_t>(std::time(nullptr));
+        // The header is written again at the end, with the size of the terminal: room is kept for the largest one.
+        width = height = 99999;
+        header_len = 0;
+        write_header();
+        width = height = 0;
+        return file.good();
+    }
+
+    bool CastRecorder::is_open(void) const {
+        return file.is_open();
+    }
+
+    void CastRecorder::write_header(void) {
+        std::string header = "{\"version\": 2, \"width\": " + std::to_string(std::max<size_t>(width, 1))
+            + ", \"height\": " + std::to_string(std::max<size_t>(height, 1))
+            + ", \"timestamp\": " + std::to_string(start_time)
+            + ", \"title\": \"";
+        append_json(title, header);
+        header += "\"}";
+        if (header_len == 0) {
+            header_len = header.size() + 1;
+        }
+        // Spaces after the JSON object are fine for the players.
+        header.resize(header_len - 1, ' ');
+        header += '\n';
+        file.write(header.data(), header.size());
+    }
+
+    void CastRecorder::add_frame(std::string_view frame, double time) {
+        frame_bytes += frame.size();
+        //* [1] Split the frame in lines. Each line starts with the last escape sequence before it
+        // (they all set the whole style), so it may be drawn alone.
+        lines.clear();
+        spans.clear();
+        std::string_view style; ///< The last escape sequence seen.
+        size_t begin{0};
+        while (begin < frame.size()) {
+            size_t end = frame.find('\n', begin);
+            end = (end == std::string_view::npos) ? frame.size() : end;
+            std::string_view line = frame.substr(begin, end - begin);
+            size_t offset = lines.size();
+            lines.append(style).append(line);
+            spans.emplace_back(offset, lines.size() - offset);
+            width = std::max(width, FrameCompositor::width_of(line));
+            size_t esc = line.rfind('\e');
+            if (esc != std::string_view::npos) {
+                size_t m = line.find('m', esc);
+                style = line.substr(esc, (m == std::string_view::npos) ? std::string_view::npos : m - esc + 1);
+            }
+            begin = end + 1;
+        }
+        // The cursor ends on the line after the frame, which must not scroll it.
+        height = std::max(height, spans.size() + 1);
+
+        //* [2] The first frame is drawn in full, the other ones only on the lines that changed.
+        payload.clear();
+        if (n_events == 0) {
+            payload += "\e[H\e[2J";
+            for (char c : frame) {
+                if (c == '\n') {
+                    payload += '\r';
+                }
+                payload += c;
+            }
+        }
+        else {
+            for (size_t i{0}; i < spans.size(); i++) {
+                std::string_view line(lines.data() + spans[i].first, spans[i].second);
+                std::string_view prev;
+                if (i < prev_spans.size()) {
+                    prev = std::string_view(prev_lines.data() + prev_spans[i].first, prev_spans[i].second);
+                    if (line == prev) {
+                        continue;
+                    }
+                }
+                // Only the part after the beginning both lines share is drawn, from its column and with its style.
+                size_t same{0};
+                while (same < line.size() and same < prev.size() and line[same] == prev[same]) {
+                    same++;
+                }
+                size_t pos{0}, column{0};
+                std::string_view style;
+                while (pos < line.size()) {
+                    size_t end = pos + 1;
+                    if (line[pos] == '\e') {
+                        end = line.find('m', pos);
+                        end = (end == std::string_view::npos) ? line.size() : end + 1;
+                    }
+                    else {
+                        while (end < line.size() and (static_cast<unsigned char>(line[end]) & 0xC0) == 0x80) {
+                            end++;
+                        }
+                    }
+                    if (end > same) {
+                        break;
+                    }
+                    if (line[pos] == '\e') {
+                        style = line.substr(pos, end - pos);
+                    }
+                    else {
+                        column++;
+                    }
+                    pos = end;
+                }
+                append_goto(i + 1, column + 1, payload);
+                payload.append(Color::RESET, Color::RESET_LEN).append(style).append(line.substr(pos));
+                payload.append(Color::RESET, Color::RESET_LEN).append("\e[K");
+            }
+            // Erase the lines of the previous frame below this one.
+            if (spans.size() < prev_spans.size()) {
+                append_goto(spans.size() + 1, 1, payload);
+                payload += "\e[J";
+            }
+            if (not payload.empty()) {
+                append_goto(spans.size() + 1, 1, payload);
+            }
+        }
+        std::swap(lines, prev_lines);
+        std::swap(spans, prev_spans);
+        if (payload.empty()) {
+            return;
+        }
+
+        //* [3] Write the event.
+        char time_text[32];
+        std::snprintf(time_text, sizeof(time_text), "%.6f", time);
+        event.clear();
+        event.append("[").append(time_text).append(", \"o\", \"");
+        append_json(payload, event);
+        event.append("\"]\n");
+        file.write(event.data(), event.size());
+        event_bytes += payload.size();
+        n_events++;
+    }
+
+    bool CastRecorder::close(void) {
+        if (not file.is_open()) {
+            return false;
+        }
+        file.seekp(0);
+        write_header();
+        bool ok = file.good();
+        file.close();
+        return ok;
+    }
+
+    uint64_t CastRecorder::get_n_events(void) const {
+        return n_events;
+    }
+
+    uint64_t CastRecorder::get_frame_bytes(void) const {
+        return frame_bytes;
+    }
+
+    uint64_t CastRecorder::get_event_bytes(void) const {
+        return event_bytes;
+    }
+
+    //============[ CastPlayer METHODS ]===============//
+
+    bool CastPlayer::play(const std::string &file_name, bool wait, std::string &err) {
+        std::unique_ptr<InputSource> source = InputSource::open(file_name, InputSource::MMAP, err);
+        if (source == nullptr) {
+            return false;
+        }
+        LineReader reader(*source);
+        std::string_view line;
+        //* [1] The header is a JSON object with "version": 2.
+        bool valid{false};
+        if (reader.next(line) and not line.empty() and line[0] == '{') {
+            size_t pos = line.find("\"version\"");
+            if (pos != std::string_view::npos) {
+                pos = line.find_first_not_of(" :", pos + 9);
+                valid = pos != std::string_view::npos and line[pos] == '2';
+            }
+        }
+        if (not valid) {
+            err = "it isn't an asciicast v2 file";
+            return false;
+        }
+
+        //* [2] Each event is [time, "type", "data"], and only the output ("o") events are played.
+        std::cout.flush();
+        std::string data;
+        auto start = std::chrono::steady_clock::now();
+        size_t line_no{1};
+        while (reader.next(line)) {
+            line_no++;
+            if (line.find_first_not_of(" \t\r") == std::string_view::npos) {
+                continue;
+            }
+            double time{0};
+            size_t open = line.find('[');
+            size_t type = line.find('"');
+            size_t type_end = (type == std::string_view::npos) ? type : line.find('"', type + 1);
+            size_t quote = (type_end == std::string_view::npos) ? type_end : line.find('"', type_end + 1);
+            if (open == std::string_view::npos or quote == std::string_view::npos) {
+                err = "broken event in line " + std::to_string(line_no);
+                return false;
+            }
+            size_t num = line.find_first_not_of(' ', open + 1);
+            if (std::from_chars(line.data() + num, line.data() + type, time).ec != std::errc{}) {
+                err = "broken time in line " + std::to_string(line_no);
+                return false;
+            }
+            data.clear();
+            if (decode_string(line.substr(quote + 1), data) == std::string::npos) {
+                err = "broken text in line " + std::to_string(line_no);
+                return false;
+            }
+            if (line.substr(type + 1, type_end - type - 1) != "o") {
+                continue;
+            }
+            if (wait) {
+                std::this_thread::sleep_until(start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                    std::chrono::duration<double>(time)));
+            }
+            // The whole event in a single write (the text is escaped in the file, so it can't be sent as it is).
+            for (size_t done{0}; done < data.size();) {
+                ssize_t n = ::write(STDOUT_FILENO, data.data() + done, data.size() - done);
+                if (n <= 0) {
+                    err = "the output was closed";
+                    return false;
+                }
+                done += n;
+            }
+            n_events++;
+        }
+        if (source->failed()) {
+            err = "input/output or decompression error";
+            return false;
+        }
+        return true;
+    }
+
+    uint64_t CastPlayer::get_n_events(void) const {
+        return n_events;
+    }
+
+    size_t CastPlayer::decode_string(std::string_view str, std::string &out) {
+        // Read 4 hexadecimal digits.
+        auto hex4 = [&str](size_t at, uint32_t &code) {
+            if (at + 4 > str.size()) {
+                return false;
+            }
+            code = 0;
+            for (size_t k{at}; k < at + 4; k++) {
+                char c = str[k];
+                uint32_t digit = (c >= '0' and c <= '9') ? c - '0'
+                    : (c >= 'a' and c <= 'f') ? c - 'a' + 10
+                    : (c >= 'A' and c <= 'F') ? c - 'A' + 10 : 16;
+                if (digit == 16) {
+                    return false;
+                }
+                code = code * 16 + digit;
+            }
+            return true;
+        };
+        size_t i{0};
+        while (i < str.size()) {
+            char c = str[i];
+            if (c == '"') {
+                return i;
+            }
+            if (c != '\\') {
+                out += c;
+                i++;
+                continue;
+            }
+            if (i + 1 >= str.size()) {
+                return std::string::npos;
+            }
+            char e = str[i + 1];
+            i += 2;
+            switch (e) {
+                case 'n': out += '\n'; break;
+                case 'r': out += '\r'; break;
+                case 't': out += '\t'; break;
+                case 'b': out += '\b'; break;
+                case 'f': out += '\f'; break;
+                case '/': out += '/'; break;
+                case '\\': out += '\\'; break;
+                case '"': out += '"'; break;
+                case 'u': {
+                    uint32_t code, low;
+                    if (not hex4(i, code)) {
+                        return std::string::npos;
+                    }
+                    i += 4;
+                    // A surrogate pair gives a character out of the first plane.
+                    if (code >= 0xD800 and code < 0xDC00 and i + 6 <= str.size() and str[i] == '\\' and str[i + 1] == 'u'
+                        and hex4(i + 2, low) and low >= 0xDC00 and low < 0xE000) {
+                        code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                        i += 6;
+                    }
+                    append_utf8(code, out);
+                    break;
+                }
+                default:
+                    return std::string::npos;
+            }
+        }
+        return std::string::npos;
+    }
+
+    //============[ End CastPlayer class ]===============//
+
+} // namespace bcr
@@ -33,6 +33,9 @@ namespace bcr {
     std::string BarChart::get_timestamp(void) const {
         return "Time Stamp: " + bc_timestamp;
     }
+    std::string BarChart::get_time(void) const {
+        return bc_timestamp;
+    }
     
     //============[ End BarChart class ]===============//
 
@@ -53,10 +56,20 @@ namespace bcr {
     void Database::set_source_info(std::string source_info) {
         chart_source_info = source_info;
     }
+    uint32_t Database::add_category(std::string_view name) {
+        auto [it, inserted] = category_ids.try_emplace(std::string(name), categories.size());
+        if (inserted) {
+            categories.push_back(it->first);
+        }
+        return it->second;
+    }
     
     std::shared_ptr<BarChart> Database::get_chart(void) {
         return data_set[current_bc];
     }
+    std::shared_ptr<BarChart> Database::get_chart(std::size_t index) {
+        return data_set[index];
+    }
     std::size_t Database::get_n_charts(void) {
         return data_set.size();
     }
@@ -72,6 +85,9 @@ namespace bcr {
     std::string Database::get_source_info(void) const {
         return chart_source_info;
     }
+    const std::vector<std::string>& Database::get_categories(void) const {
+        return categories;
+    }
 
     //============[ End Database class ]===============//
 
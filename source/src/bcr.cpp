@@ -12,8 +12,6 @@
  * 
  */
 
-#include <cstdlib> ///< EXIT_SUCCESS
-
 #include "animation_mgr.h"
 
 int main(int argc, char *argv[]) {
@@ -28,5 +26,5 @@ int main(int argc, char *argv[]) {
         am.render();
     }
 
-    return EXIT_SUCCESS;
+    return am.get_exit_status();
 }
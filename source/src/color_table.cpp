@@ -0,0 +1,200 @@
+/*!
+ * @file color_table.cpp
+ * @author João Guilherme Lopes Alves da Costa (joguicosta@hotmail.com)
+ * @brief Implementation of the color table class.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#include <algorithm> ///< To sort the categories by name.
+#include <cmath> ///< To use fmod and fabs.
+#include <cstdlib> ///< To use getenv.
+
+#include "../lib/text_color.h"
+#include "color_table.h"
+
+/*!
+ * @namespace bcr contains all the classes used in the bar chart race.
+ */
+namespace bcr {
+    //* Number of hues used in true color mode.
+    static constexpr size_t TRUECOLOR_SLOTS{360};
+
+    /**
+     * @brief Hash a text (FNV-1a), so a category always lands in the same palette slot.
+     */
+    static uint64_t hash_name(const std::string &str) {
+        uint64_t hash{14695981039346656037ull};
+        for (unsigned char c : str) {
+            hash = (hash ^ c) * 1099511628211ull;
+        }
+        return hash;
+    }
+
+    /**
+     * @brief Get the colors of the 256 colors cube (16 to 231) that can be read in a dark terminal.
+     */
+    static std::vector<int> extended_palette(void) {
+        std::vector<int> palette;
+        for (int r{0}; r < 6; r++) {
+            for (int g{0}; g < 6; g++) {
+                for (int b{0}; b < 6; b++) {
+                    // Skip the dark ones.
+                    if (std::max({r, g, b}) >= 3) {
+                        palette.push_back(16 + 36*r + 6*g + b);
+                    }
+                }
+            }
+        }
+        return palette;
+    }
+
+    /**
+     * @brief Get the SGR parameters of a slot: a hue (HSV with fixed saturation and value),
+     * spread by the golden angle so neighbor slots have distant hues.
+     */
+    static std::string truecolor_code(size_t slot) {
+        size_t hue = (slot * 137) % TRUECOLOR_SLOTS;
+        double s{0.65}, v{0.95};
+        double c = v * s;
+        double x = c * (1 - std::fabs(std::fmod(hue / 60.0, 2) - 1));
+        double m = v - c;
+        double rgb[3];
+        switch (hue / 60) {
+            case 0: rgb[0] = c; rgb[1] = x; rgb[2] = 0; break;
+            case 1: rgb[0] = x; rgb[1] = c; rgb[2] = 0; break;
+            case 2: rgb[0] = 0; rgb[1] = c; rgb[2] = x; break;
+            case 3: rgb[0] = 0; rgb[1] = x; rgb[2] = c; break;
+            case 4: rgb[0] = x; rgb[1] = 0; rgb[2] = c; break;
+            default: rgb[0] = c; rgb[1] = 0; rgb[2] = x; break;
+        }
+        std::string code{"38;2"};
+        for (double channel : rgb) {
+            code += ";" + std::to_string(static_cast<int>((channel + m) * 255));
+        }
+        return code;
+    }
+
+    //============[ ColorTable METHODS ]===============//
+
+    void ColorTable::assign(const std::vector<std::string> &categories, Depth depth,
+                            const std::vector<std::string> &shared) {
+        // The names that share the palette, in order and without repeats.
+        std::vector<std::string> names = shared;
+        names.insert(names.end(), categories.begin(), categories.end());
+        std::sort(names.begin(), names.end());
+        names.erase(std::unique(names.begin(), names.end()), names.end());
+
+        //* [1] Choose the color depth.
+        if (depth == AUTO) {
+            const char *colorterm = std::getenv("COLORTERM");
+            std::string term = (colorterm != nullptr) ? colorterm : "";
+            if (names.size() <= Color::color_list.size()) {
+                depth = BASIC;
+            }
+            else if (term == "truecolor" or term == "24bit") {
+                depth = TRUECOLOR;
+            }
+            else {
+                depth = EXTENDED;
+            }
+        }
+        this->depth = depth;
+
+        //* [2] The number of slots of the palette.
+        std::vector<int> palette;
+        size_t n_slots;
+        if (depth == BASIC) {
+            n_slots = Color::color_list.size();
+        }
+        else if (depth == EXTENDED) {
+            palette = extended_palette();
+            n_slots = palette.size();
+        }
+        else {
+            n_slots = TRUECOLOR_SLOTS;
+        }
+
+        //* [3] Hash each name to a slot. While there are free slots, a taken slot is
+        // solved by taking the next free one, visiting the names in order so the
+        // result doesn't depend on the order they appear in the files.
+        std::vector<bool> taken(n_slots, false);
+        std::vector<size_t> name_slot(names.size());
+        bool probe = names.size() <= n_slots;
+        for (size_t i{0}; i < names.size(); i++) {
+            size_t slot = hash_name(names[i]) % n_slots;
+            while (probe and taken[slot]) {
+                slot = (slot + 1) % n_slots;
+            }
+            taken[slot] = true;
+            name_slot[i] = slot;
+        }
+        std::vector<size_t> slot_of(categories.size());
+        for (size_t id{0}; id < categories.size(); id++) {
+            auto it = std::lower_bound(names.begin(), names.end(), categories[id]);
+            slot_of[id] = name_slot[it - names.begin()];
+        }
+
+        //* [4] Build the escape sequences of each category.
+        regular.assign(categories.size(), "");
+        bold.assign(categories.size(), "");
+        for (size_t id{0}; id < categories.size(); id++) {
+            std::string code;
+            if (depth == BASIC) {
+                code = std::to_string(Color::color_list[slot_of[id]]);
+            }
+            else if (depth == EXTENDED) {
+                code = "38;5;" + std::to_string(palette[slot_of[id]]);
+            }
+            else {
+                code = truecolor_code(slot_of[id]);
+            }
+            regular[id] = "\e[" + std::to_string(Color::REGULAR) + ";" + code + "m";
+            bold[id] = "\e[" + std::to_string(Color::BOLD) + ";" + code + "m";
+        }
+    }
+
+    const std::string& ColorTable::begin(uint32_t id, bool bold) const {
+        return bold ? this->bold[id] : regular[id];
+    }
+
+    std::string ColorTable::tcolor(const std::string &msg, uint32_t id, bool bold) const {
+        return begin(id, bold) + msg + "\e[0m";
+    }
+
+    ColorTable::Depth ColorTable::get_depth(void) const {
+        return depth;
+    }
+
+    const char* ColorTable::depth_name(Depth depth) {
+        switch (depth) {
+            case AUTO: return "auto";
+            case BASIC: return "16";
+            case EXTENDED: return "256";
+            case TRUECOLOR: return "truecolor";
+        }
+        return "unknown";
+    }
+
+    bool ColorTable::parse_depth(const std::string &str, Depth &depth) {
+        if (str == "16") {
+            depth = BASIC;
+        }
+        else if (str == "256") {
+            depth = EXTENDED;
+        }
+        else if (str == "truecolor" or str == "24bit") {
+            depth = TRUECOLOR;
+        }
+        else {
+            return false;
+        }
+        return true;
+    }
+
+    //============[ End ColorTable class ]===============//
+
+} // namespace bcr
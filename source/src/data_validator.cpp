@@ -0,0 +1,465 @@
+/*!
+ * @file data_validator.cpp
+ * @author João Guilherme Lopes Alves da Costa (joguicosta@hotmail.com)
+ * @brief Implementation of the data validator class.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#include <algorithm> ///< To sort the issues.
+#include <cctype> ///< To use isdigit.
+#include <charconv> ///< To parse the numbers without copying them (from_chars).
+#include <cstring> ///< To use memchr.
+#include <string_view> ///< To find the last line break of a chunk.
+#include <thread> ///< To scan the chunks in parallel.
+
+#include "data_validator.h"
+#include "input_source.h"
+
+/*!
+ * @namespace bcr contains all the classes used in the bar chart race.
+ */
+namespace bcr {
+    //============[ DataValidator METHODS ]===============//
+
+    DataValidator::DataValidator(size_t n_threads) : n_threads{n_threads} {
+        if (this->n_threads == 0) {
+            this->n_threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+    }
+
+    const char* DataValidator::code_name(IssueCode code) {
+        switch (code) {
+            case NONE: return "none";
+            case UNREADABLE: return "unreadable";
+            case MISSING_HEADER: return "missing-header";
+            case BAD_COUNT: return "bad-count";
+            case COUNT_MISMATCH: return "count-mismatch";
+            case ORPHAN_RECORD: return "orphan-record";
+            case BLANK_IN_BLOCK: return "blank-in-block";
+            case FIELD_COUNT: return "field-count";
+            case EMPTY_FIELD: return "empty-field";
+            case BAD_VALUE: return "bad-value";
+            case TIMESTAMP_ORDER: return "timestamp-order";
+        }
+        return "unknown";
+    }
+
+    bool DataValidator::is_blank(std::string_view line) {
+        return line.find_first_not_of(" \t\r") == std::string_view::npos;
+    }
+
+    bool DataValidator::parse_block_header(std::string_view line, size_t &n_bars) {
+        size_t first = line.find_first_not_of(" \t");
+        size_t last = line.find_last_not_of(" \t\r");
+        if (first == std::string_view::npos) {
+            return false;
+        }
+        line = line.substr(first, last - first + 1);
+        auto [ptr, ec] = std::from_chars(line.data(), line.data() + line.size(), n_bars);
+        return ec == std::errc() and ptr == line.data() + line.size();
+    }
+
+    DataValidator::IssueCode DataValidator::parse_record(std::string_view line, RecordFields &fields, value_t &value) {
+        // Only the first 4 commas split fields.
+        uint32_t commas[4];
+        size_t n_commas{0};
+        for (size_t pos = line.find(','); pos != std::string_view::npos and n_commas < 4; pos = line.find(',', pos + 1)) {
+            commas[n_commas++] = static_cast<uint32_t>(pos);
+        }
+        return parse_record(line, commas, n_commas, fields, value);
+    }
+
+    DataValidator::IssueCode DataValidator::parse_record(std::string_view line, const uint32_t *commas, size_t n_commas,
+                                                         RecordFields &fields, value_t &value) {
+        if (not line.empty() and line.back() == '\r') {
+            line.remove_suffix(1);
+        }
+        fields = RecordFields{};
+        if (n_commas < 4) {
+            return FIELD_COUNT;
+        }
+        fields.time = line.substr(0, commas[0]);
+        fields.label = line.substr(commas[0] + 1, commas[1] - commas[0] - 1);
+        fields.info = line.substr(commas[1] + 1, commas[2] - commas[1] - 1);
+        fields.value = line.substr(commas[2] + 1, commas[3] - commas[2] - 1);
+        // The category is the rest of the line.
+        fields.category = line.substr(commas[3] + 1);
+        if (fields.time.empty() or fields.label.empty()) {
+            return EMPTY_FIELD;
+        }
+        std::string_view number = fields.value;
+        size_t first = number.find_first_not_of(' ');
+        size_t last = number.find_last_not_of(' ');
+        if (first == std::string_view::npos) {
+            return BAD_VALUE;
+        }
+        number = number.substr(first, last - first + 1);
+        if (not ValueTraits<value_t>::parse(number, value)) {
+            return BAD_VALUE;
+        }
+        return NONE;
+    }
+
+    int DataValidator::compare_timestamps(std::string_view a, std::string_view b) {
+        auto only_digits = [](std::string_view s) {
+            return not s.empty() and s.find_first_not_of("0123456789") == std::string_view::npos;
+        };
+        // Numbers with more digits are bigger (e.g. 999 < 1000).
+        if (only_digits(a) and only_digits(b) and a.size() != b.size()) {
+            return a.size() < b.size() ? -1 : 1;
+        }
+        return a.compare(b);
+    }
+
+    void DataValidator::scan_chunk(const char *begin, const char *end, size_t base_byte, ChunkResult &res) {
+        const char *p = begin;
+        std::string_view prev_time;
+        // Extend the last run of lines or start a new one.
+        auto push_run = [&res](SegmentKind kind, size_t line, size_t byte) {
+            if (kind != HEADER and not res.segments.empty() and res.segments.back().kind == kind) {
+                res.segments.back().count++;
+            }
+            else {
+                res.segments.push_back({kind, line, byte, 1});
+            }
+        };
+        while (p < end) {
+            const char *nl = static_cast<const char*>(std::memchr(p, '\n', end - p));
+            const char *line_end = (nl != nullptr) ? nl : end;
+            std::string_view line(p, line_end - p);
+            size_t line_no = res.n_lines;
+            size_t byte = base_byte + (p - begin);
+            size_t n_bars;
+
+            if (is_blank(line)) {
+                push_run(BLANKS, line_no, byte);
+            }
+            else if (parse_block_header(line, n_bars)) {
+                if (n_bars == 0) {
+                    res.issues.push_back({line_no, byte, BAD_COUNT, "block header declares 0 bars"});
+                }
+                res.segments.push_back({HEADER, line_no, byte, n_bars});
+            }
+            else if (line.find(',') == std::string_view::npos and std::isdigit(static_cast<unsigned char>(line[0]))) {
+                // A number that doesn't fit (or has garbage after it): it's a broken header, not a record.
+                res.issues.push_back({line_no, byte, BAD_COUNT, "invalid block header \"" + std::string(line) + "\""});
+                res.segments.push_back({HEADER, line_no, byte, 0});
+            }
+            else {
+                RecordFields fields;
+                value_t value;
+                IssueCode code = parse_record(line, fields, value);
+                if (code == FIELD_COUNT) {
+                    size_t n_fields = std::count(line.begin(), line.end(), ',') + 1;
+                    res.issues.push_back({line_no, byte, code,
+                        "record has " + std::to_string(n_fields) + " field(s), expected 5"});
+                }
+                else if (code == EMPTY_FIELD) {
+                    res.issues.push_back({line_no, byte, code,
+                        fields.time.empty() ? "record has an empty time stamp" : "record has an empty label"});
+                }
+                else if (code == BAD_VALUE) {
+                    res.issues.push_back({line_no, byte, code,
+                        "value \"" + std::string(fields.value) + "\" is not a valid number"});
+                }
+                // Check the time stamps order, even across blocks.
+                if (code != FIELD_COUNT and not fields.time.empty()) {
+                    if (prev_time.empty()) {
+                        res.first_time = fields.time;
+                        res.first_time_line = line_no;
+                        res.first_time_byte = byte;
+                    }
+                    else if (compare_timestamps(fields.time, prev_time) < 0) {
+                        res.issues.push_back({line_no, byte, TIMESTAMP_ORDER,
+                            "time stamp \"" + std::string(fields.time) + "\" is older than the previous one \""
+                            + std::string(prev_time) + "\""});
+                    }
+                    prev_time = fields.time;
+                }
+                push_run(RECORDS, line_no, byte);
+            }
+            res.n_lines++;
+            p = (nl != nullptr) ? nl + 1 : end;
+        }
+        res.last_time = prev_time;
+    }
+
+    void DataValidator::add_issue(size_t line, size_t byte, IssueCode code, std::string message) {
+        issues.push_back({line, byte, code, std::move(message)});
+    }
+
+    //* Message of a run of orphan record lines.
+    static std::string orphan_message(size_t n_orphans) {
+        return std::to_string(n_orphans) + " record line(s) don't belong to any block";
+    }
+
+    void DataValidator::close_block(void) {
+        blocks.push_back({stitching.header.line, stitching.last_line});
+        stitching.remaining = 0;
+    }
+
+    void DataValidator::stitch(ChunkResult &res, const char *begin, const char *end, size_t base_byte) {
+        StitchState &st = stitching;
+        //* [1] Turn the line numbers of the chunk into absolute ones.
+        for (auto &issue : res.issues) {
+            issue.line += st.line_base;
+            issues.push_back(std::move(issue));
+        }
+
+        //* [2] Check the first time stamp of the chunk against the last one of the previous chunks.
+        if (not res.first_time.empty()) {
+            if (not st.prev_time.empty() and compare_timestamps(res.first_time, st.prev_time) < 0) {
+                add_issue(st.line_base + res.first_time_line, res.first_time_byte, TIMESTAMP_ORDER,
+                    "time stamp \"" + std::string(res.first_time) + "\" is older than the previous one \""
+                    + st.prev_time + "\"");
+            }
+            st.prev_time = res.last_time;
+        }
+
+        //* [3] Check if each block header matches the number of records that follow it.
+        for (auto seg : res.segments) {
+            seg.line += st.line_base;
+            // A run of lines may go on from the previous chunk.
+            bool goes_on = (seg.kind != HEADER and seg.kind == st.last_kind);
+            st.last_kind = seg.kind;
+            if (not goes_on) {
+                st.n_orphans = 0;
+            }
+            if (seg.kind == HEADER) {
+                if (st.remaining > 0) {
+                    add_issue(st.header.line, st.header.byte, COUNT_MISMATCH,
+                        "block declares " + std::to_string(st.declared) + " bar(s) but only "
+                        + std::to_string(st.declared - st.remaining) + " record(s) follow it");
+                    close_block();
+                }
+                st.header = seg;
+                st.declared = st.remaining = seg.count;
+                st.last_line = seg.line;
+                if (st.remaining == 0) {
+                    close_block();
+                }
+            }
+            else if (seg.kind == RECORDS) {
+                size_t taken = std::min(st.remaining, seg.count);
+                if (taken > 0) {
+                    st.remaining -= taken;
+                    st.last_line = seg.line + taken - 1;
+                    if (st.remaining == 0) {
+                        close_block();
+                    }
+                }
+                if (taken < seg.count and st.n_orphans > 0) {
+                    // The orphan lines go on from the previous chunk: they are a single issue.
+                    st.n_orphans += seg.count;
+                    issues[st.orphan_issue].message = orphan_message(st.n_orphans);
+                }
+                else if (taken < seg.count) {
+                    // Find where the first orphan line begins.
+                    const char *line = begin + (seg.byte - base_byte);
+                    for (size_t i{0}; i < taken; i++) {
+                        line = static_cast<const char*>(std::memchr(line, '\n', end - line)) + 1;
+                    }
+                    st.orphan_issue = issues.size();
+                    st.n_orphans = seg.count - taken;
+                    add_issue(seg.line + taken, base_byte + (line - begin), ORPHAN_RECORD, orphan_message(st.n_orphans));
+                }
+            }
+            else if (st.remaining > 0) {
+                add_issue(seg.line, seg.byte, BLANK_IN_BLOCK,
+                    "blank line inside a block, " + std::to_string(st.remaining) + " more record(s) expected");
+                // The blank line is the fault of the block, so it ends the block.
+                st.last_line = seg.line;
+                close_block();
+            }
+        }
+        st.line_base += res.n_lines;
+    }
+
+    void DataValidator::finish_stitch(void) {
+        StitchState &st = stitching;
+        if (st.remaining > 0) {
+            add_issue(st.header.line, st.header.byte, COUNT_MISMATCH,
+                "block declares " + std::to_string(st.declared) + " bar(s) but the file ends after "
+                + std::to_string(st.declared - st.remaining) + " record(s)");
+            close_block();
+        }
+        n_lines = st.line_base - 1;
+    }
+
+    bool DataValidator::scan_mapped(const char *data, size_t size) {
+        //* [1] Skip the title, label and source lines.
+        size_t start{0};
+        for (size_t i{0}; i < 3; i++) {
+            const void *nl = (start < size) ? std::memchr(data + start, '\n', size - start) : nullptr;
+            if (nl == nullptr) {
+                add_issue(i + 1, start, MISSING_HEADER,
+                    "file ends before the title, label and source lines");
+                n_lines = i + 1;
+                return false;
+            }
+            start = static_cast<const char*>(nl) - data + 1;
+        }
+
+        //* [2] Split the rest of the file in chunks that begin at the start of a line.
+        size_t n_chunks = std::min<size_t>(n_threads, (size - start) / (1 << 20) + 1);
+        std::vector<size_t> bounds{start};
+        for (size_t i{1}; i < n_chunks; i++) {
+            size_t pos = std::max(bounds.back(), start + (size - start) / n_chunks * i);
+            const void *nl = (pos < size) ? std::memchr(data + pos, '\n', size - pos) : nullptr;
+            bounds.push_back(nl == nullptr ? size : static_cast<const char*>(nl) - data + 1);
+        }
+        bounds.push_back(size);
+
+        //* [3] Scan the chunks in parallel.
+        std::vector<ChunkResult> results(bounds.size() - 1);
+        std::vector<std::thread> workers;
+        for (size_t i{1}; i < results.size(); i++) {
+            workers.emplace_back(scan_chunk, data + bounds[i], data + bounds[i+1], bounds[i], std::ref(results[i]));
+        }
+        scan_chunk(data + bounds[0], data + bounds[1], bounds[0], results[0]);
+        for (auto &w : workers) {
+            w.join();
+        }
+
+        //* [4] Join the results, in order, and check what crosses the chunks.
+        for (size_t i{0}; i < results.size(); i++) {
+            stitch(results[i], data + bounds[i], data + bounds[i+1], bounds[i]);
+        }
+        finish_stitch();
+        return true;
+    }
+
+    bool DataValidator::scan_stream(InputSource &source, const std::string &file_name) {
+        std::string carry; ///< The beginning of a line that ends in the next chunk.
+        size_t offset{0}; ///< The byte offset of the first byte not scanned yet.
+        size_t n_titles{0}; ///< How many of the title, label and source lines were read.
+        size_t start{0}; ///< The byte offset of the first line after them.
+        // Scan complete lines, skipping the title, label and source lines first.
+        auto feed = [&](const char *begin, const char *end) {
+            const char *p = begin;
+            while (n_titles < 3 and p < end) {
+                const void *nl = std::memchr(p, '\n', end - p);
+                if (nl == nullptr) {
+                    // Only the last line of the file may have no line break.
+                    break;
+                }
+                p = static_cast<const char*>(nl) + 1;
+                start = offset + (p - begin);
+                n_titles++;
+            }
+            if (n_titles == 3 and p < end) {
+                ChunkResult res;
+                scan_chunk(p, end, offset + (p - begin), res);
+                stitch(res, p, end, offset + (p - begin));
+            }
+            offset += end - begin;
+        };
+
+        //* [1] Scan the complete lines of each chunk where they are. The line cut by the end of the chunk
+        // is carried to the next one.
+        InputSource::Chunk chunk;
+        while (source.next(chunk)) {
+            const char *p = chunk.data;
+            const char *end = chunk.data + chunk.size;
+            if (not carry.empty()) {
+                const void *nl = std::memchr(p, '\n', end - p);
+                if (nl == nullptr) {
+                    carry.append(p, end);
+                    continue;
+                }
+                p = static_cast<const char*>(nl) + 1;
+                carry.append(chunk.data, p);
+                feed(carry.data(), carry.data() + carry.size());
+                carry.clear();
+            }
+            size_t last_nl = std::string_view(p, end - p).rfind('\n');
+            if (last_nl != std::string_view::npos) {
+                feed(p, p + last_nl + 1);
+                p += last_nl + 1;
+            }
+            carry.assign(p, end);
+        }
+        if (source.failed()) {
+            add_issue(0, 0, UNREADABLE, "couldn't read the file \"" + file_name + "\" (input/output or decompression error)");
+            return false;
+        }
+        //* [2] The last line of the file.
+        if (not carry.empty()) {
+            feed(carry.data(), carry.data() + carry.size());
+        }
+        if (n_titles < 3) {
+            add_issue(n_titles + 1, start, MISSING_HEADER,
+                "file ends before the title, label and source lines");
+            n_lines = n_titles + 1;
+            return false;
+        }
+        finish_stitch();
+        return true;
+    }
+
+    bool DataValidator::validate(const std::string &file_name) {
+        issues.clear();
+        blocks.clear();
+        n_bad_blocks = 0;
+        n_lines = 0;
+        stitching = StitchState{};
+
+        //* [1] Scan the file. It's mapped when possible, so the threads can read it without copies,
+        // otherwise (e.g. compressed files and pipes) it's scanned as it's read.
+        std::string err;
+        std::unique_ptr<InputSource> source = InputSource::open(file_name, InputSource::MMAP, err);
+        if (source == nullptr) {
+            add_issue(0, 0, UNREADABLE, "couldn't open the file \"" + file_name + "\": " + err);
+            return false;
+        }
+        auto *mapped = dynamic_cast<MappedSource*>(source.get());
+        if (mapped != nullptr) {
+            mapped->will_need();
+        }
+        bool scanned = (mapped != nullptr) ? scan_mapped(mapped->data(), mapped->size())
+                                           : scan_stream(*source, file_name);
+        if (not scanned) {
+            return false;
+        }
+        std::stable_sort(issues.begin(), issues.end(), [](const Issue &a, const Issue &b) {
+            return a.line < b.line;
+        });
+
+        //* [2] Count the blocks that have at least one issue.
+        for (const auto &block : blocks) {
+            auto it = std::lower_bound(issues.begin(), issues.end(), block.first, [](const Issue &a, size_t line) {
+                return a.line < line;
+            });
+            if (it != issues.end() and it->line <= block.second) {
+                n_bad_blocks++;
+            }
+        }
+        return issues.empty();
+    }
+
+    void DataValidator::report(std::ostream &os) const {
+        for (const auto &issue : issues) {
+            os << issue.line << '\t' << issue.byte << '\t' << code_name(issue.code) << '\t' << issue.message << '\n';
+        }
+    }
+
+    const std::vector<DataValidator::Issue>& DataValidator::get_issues(void) const {
+        return issues;
+    }
+    size_t DataValidator::get_n_blocks(void) const {
+        return blocks.size();
+    }
+    size_t DataValidator::get_n_bad_blocks(void) const {
+        return n_bad_blocks;
+    }
+    size_t DataValidator::get_n_lines(void) const {
+        return n_lines;
+    }
+
+    //============[ End DataValidator class ]===============//
+
+} // namespace bcr
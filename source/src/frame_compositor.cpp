@@ -0,0 +1,126 @@
+/*!
+ * @file frame_compositor.cpp
+ * @author João Guilherme Lopes Alves da Costa (joguicosta@hotmail.com)
+ * @brief Implementation of the frame compositor.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#include <algorithm> ///< To use min and max.
+#include <cmath> ///< To use sqrt and ceil.
+
+#include "../lib/text_color.h"
+#include "frame_compositor.h"
+
+/*!
+ * @namespace bcr contains all the classes used in the bar chart race.
+ */
+namespace bcr {
+    //* Spaces between two cells of a row.
+    static constexpr size_t CELL_GAP{4};
+
+    //============[ FrameCompositor METHODS ]===============//
+
+    FrameCompositor::FrameCompositor(size_t n_columns, size_t cell_width)
+        : n_columns{std::max<size_t>(n_columns, 1)}, cell_width{cell_width} {}
+
+    size_t FrameCompositor::columns_for(size_t n_races) {
+        return std::max<size_t>(1, static_cast<size_t>(std::ceil(std::sqrt(static_cast<double>(n_races)))));
+    }
+
+    void FrameCompositor::compose(const std::vector<std::string_view> &frames, std::string &out) {
+        for (size_t first{0}; first < frames.size(); first += n_columns) {
+            size_t n_cells = std::min(n_columns, frames.size() - first);
+            //* [1] Split the frames of the row in lines.
+            lines.resize(n_cells);
+            size_t n_lines{0};
+            for (size_t c{0}; c < n_cells; c++) {
+                std::string_view frame = frames[first + c];
+                lines[c].clear();
+                size_t begin{0}, end;
+                while ((end = frame.find('\n', begin)) != std::string_view::npos) {
+                    lines[c].push_back(frame.substr(begin, end - begin));
+                    begin = end + 1;
+                }
+                if (begin < frame.size()) {
+                    lines[c].push_back(frame.substr(begin));
+                }
+                n_lines = std::max(n_lines, lines[c].size());
+            }
+            //* [2] Write the row line by line, each line going through all cells.
+            for (size_t l{0}; l < n_lines; l++) {
+                // The cells after the last non empty one aren't padded.
+                size_t last{0};
+                for (size_t c{0}; c < n_cells; c++) {
+                    if (l < lines[c].size() and not lines[c][l].empty()) {
+                        last = c;
+                    }
+                }
+                for (size_t c{0}; c <= last; c++) {
+                    append_cell(l < lines[c].size() ? lines[c][l] : std::string_view{}, c < last, out);
+                    if (c < last) {
+                        out.append(CELL_GAP, ' ');
+                    }
+                }
+                out += '\n';
+            }
+        }
+    }
+
+    size_t FrameCompositor::width_of(std::string_view line) {
+        size_t width{0};
+        for (size_t i{0}; i < line.size(); i++) {
+            if (line[i] == '\e') {
+                size_t end = line.find('m', i);
+                if (end == std::string_view::npos) {
+                    break;
+                }
+                i = end;
+            }
+            else if ((static_cast<unsigned char>(line[i]) & 0xC0) != 0x80) {
+                width++;
+            }
+        }
+        return width;
+    }
+
+    void FrameCompositor::append_cell(std::string_view line, bool pad, std::string &out) const {
+        size_t width{0}; ///< Columns of the terminal used so far.
+        bool cut{false};
+        size_t i{0};
+        while (i < line.size()) {
+            // An escape sequence ends at its letter, and takes no column.
+            if (line[i] == '\e') {
+                size_t end = line.find('m', i);
+                end = (end == std::string_view::npos) ? line.size() : end + 1;
+                out.append(line.substr(i, end - i));
+                i = end;
+                continue;
+            }
+            // A character of UTF-8 is its first byte and the continuation bytes (10xxxxxx) after it.
+            size_t len{1};
+            while (i + len < line.size() and (static_cast<unsigned char>(line[i + len]) & 0xC0) == 0x80) {
+                len++;
+            }
+            if (width == cell_width) {
+                cut = true;
+                break;
+            }
+            out.append(line.substr(i, len));
+            width++;
+            i += len;
+        }
+        if (cut) {
+            out.append(Color::RESET, Color::RESET_LEN);
+        }
+        if (pad) {
+            out.append(cell_width - width, ' ');
+        }
+    }
+
+    //============[ End FrameCompositor class ]===============//
+
+} // namespace bcr
@@ -0,0 +1,354 @@
+/*!
+ * @file frame_layout.cpp
+ * @author João Guilherme Lopes Alves da Costa (joguicosta@hotmail.com)
+ * @brief Implementation of the frame layout class.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#include <algorithm> ///< To sort the legend.
+#include <cstdio> ///< To rename and remove the cache files.
+#include <cstdlib> ///< To use mkstemp.
+#include <cstring> ///< To compare the magic number.
+#include <fstream> ///< To read and write the cache file.
+#include <sstream> ///< To build the axis with ostringstream.
+
+#include <sys/stat.h> ///< To get the size and modification time of the data file.
+#include <unistd.h> ///< To use close.
+
+#include "frame_layout.h"
+
+/*!
+ * @namespace bcr contains all the classes used in the bar chart race.
+ */
+namespace bcr {
+    //* Identifies a layout cache file (and its version).
+    static constexpr char LAYOUT_MAGIC[8]{'B', 'C', 'R', 'L', 'A', 'Y', 'T', '6'};
+
+    //============[ FrameLayout METHODS ]===============//
+
+    bool FrameLayout::make_key(const std::string &file_name, size_t n_bars, size_t bar_len, uint64_t flags, Key &key) {
+        struct stat st;
+        if (::stat(file_name.c_str(), &st) != 0) {
+            return false;
+        }
+        key = Key{};
+        key.file_size = static_cast<uint64_t>(st.st_size);
+        key.file_time = static_cast<uint64_t>(st.st_mtim.tv_sec) * 1000000000ull + st.st_mtim.tv_nsec;
+        key.n_bars = n_bars;
+        key.bar_len = bar_len;
+        key.flags = flags;
+        key.value_type = ValueTraits<value_t>::ID;
+        return true;
+    }
+
+    uint64_t FrameLayout::add_text(std::string_view str) {
+        uint64_t offset = pool.size();
+        pool.append(str);
+        return offset;
+    }
+
+    std::string FrameLayout::center(const std::string &str, size_t bar_len) {
+        size_t len = (str.size() < bar_len*2) ? (bar_len*2 - str.size())/2 : 0;
+        return std::string(len, ' ') + str;
+    }
+
+    std::string FrameLayout::build_axis(size_t n_bars, size_t bar_len, const std::vector<BarChart::BarItem> &bis) {
+        using traits = ValueTraits<value_t>;
+        std::ostringstream oss;
+        size_t last{n_bars - 1}; ///< The last bar that will be printed (lower value).
+        value_t max_value = bis[0].value; ///< The value of the largest bar.
+        value_t unit = traits::unit(max_value); ///< The limits of the axis are multiples of it.
+        value_t low_value = traits::round_down(bis[last].value, unit); ///< The minimum value (after 0) that will be represented in the bar (rounds down).
+        value_t high_value = traits::add(traits::round_down(max_value, unit), unit); ///< The maximum value that will be represented in the bar (rounds up).
+        value_t aux_value{low_value}; ///< The smaller value that will be jumped.
+        size_t aux_pos_1, aux_pos_2, jumps;
+        value_t increment = (high_value - low_value) / 5; ///< The increment of the value in each position in the axis.
+
+        // If the bar value with the max value is bigger than 0.
+        if (traits::positive(max_value)) {
+            size_t low_pos = traits::scale(low_value, max_value, bar_len); ///< The position of the smallest value proportional to the size of the largest bar.
+            //* Set - and +
+            oss << "+";
+            // Display the range (0, min_value]
+            if (traits::positive(low_value)) {
+                // (low_pos may be 0 when the smallest bar is tiny next to the largest one.)
+                for (size_t i{1}; i + 1 < low_pos; i++) {
+                    oss << "-";
+                }
+                oss << "+";
+            }
+            // Print the 5 '+'.
+            for (size_t i{0}; i < 5; i++) {
+                aux_value += increment;
+                aux_pos_1 = traits::scale(aux_value, max_value, bar_len);
+                aux_pos_2 = traits::scale(aux_value - increment, max_value, bar_len);
+                if (aux_pos_1 - aux_pos_2 == 0)
+                    jumps = 0;
+                else
+                    jumps = aux_pos_1 - aux_pos_2 - 1;
+                // Print (less_value, bigger_value]
+                for (size_t j{0}; j < jumps; j++) {
+                    oss << "-";
+                }
+                oss << "+";
+            }
+            // Print the rest of the axis.
+            oss << std::setfill('-') << std::setw(bar_len * 2 - aux_pos_1) << ">" << "\n";
+            oss << std::setfill(' ');
+            //* Set numbers
+            // Each label ends at its position, and it's left out when it would run into the text before it.
+            size_t room{0}; ///< Columns since the last text printed.
+            auto put_label = [&oss, &room](const std::string &label, size_t columns) {
+                room += columns;
+                if (label.size() < room) {
+                    oss << std::setw(room) << label;
+                    room = 0;
+                }
+            };
+            aux_value = low_value;
+            // Display the first position (0)
+            if (traits::positive(low_value)) {
+                oss << "0";
+                put_label(traits::to_short_string(aux_value), low_pos);
+            }
+            else {
+                oss << std::setw(low_pos) << traits::to_short_string(aux_value);
+            }
+            for (size_t i{0}; i < 5; i++) {
+                aux_value += increment;
+                aux_pos_1 = traits::scale(aux_value, max_value, bar_len);
+                aux_pos_2 = traits::scale(aux_value - increment, max_value, bar_len);
+                if (aux_pos_1 - aux_pos_2 == 0)
+                    jumps = 0;
+                else
+                    jumps = aux_pos_1 - aux_pos_2 - 1;
+                put_label(traits::to_short_string(aux_value), jumps + 1);
+            }
+            oss << "\n";
+        }
+        else {
+            oss << "+>\n" << "0";
+        }
+
+        return oss.str();
+    }
+
+    void FrameLayout::build(Database &db, size_t n_bars, size_t bar_len, size_t n_skipped) {
+        meta = Meta{};
+        frames.clear();
+        bars.clear();
+        legend.clear();
+        pool.clear();
+
+        //* [1] The texts shared by all frames.
+        std::string title_line = center(db.get_title(), bar_len);
+        meta.title_line = add_text(title_line);
+        meta.title_line_len = title_line.size();
+        meta.title_len = db.get_title().size();
+        meta.label = add_text(db.get_label());
+        meta.label_len = db.get_label().size();
+        meta.source = add_text(db.get_source_info());
+        meta.source_len = db.get_source_info().size();
+        const std::vector<std::string> &categories = db.get_categories();
+        meta.n_categories = categories.size();
+        meta.n_skipped = n_skipped;
+        for (uint32_t id{0}; id < categories.size(); id++) {
+            LegendDesc ld{};
+            ld.text = add_text(categories[id]);
+            ld.len = categories[id].size();
+            ld.category = id;
+            legend.push_back(ld);
+        }
+        std::sort(legend.begin(), legend.end(), [this](const LegendDesc &a, const LegendDesc &b) {
+            return text(a.text, a.len) < text(b.text, b.len);
+        });
+
+        //* [2] The layout of each frame.
+        frames.reserve(db.get_n_charts());
+        for (size_t c{0}; c < db.get_n_charts(); c++) {
+            std::shared_ptr<BarChart> bc = db.get_chart(c);
+            std::vector<BarChart::BarItem> bis = bc->get_bars();
+            FrameDesc fd{};
+            fd.first_bar = bars.size();
+            fd.n_bars = std::min(bc->get_n_bars(), n_bars);
+            std::string timestamp = center(bc->get_timestamp(), bar_len);
+            fd.timestamp = add_text(timestamp);
+            fd.timestamp_len = timestamp.size();
+            std::string time = bc->get_time();
+            fd.time = add_text(time);
+            fd.time_len = time.size();
+            for (size_t i{0}; i < fd.n_bars; i++) {
+                BarDesc bd{};
+                std::string value = ValueTraits<value_t>::to_string(bis[i].value);
+                bd.text = add_text(bis[i].label);
+                add_text(value);
+                bd.label_len = bis[i].label.size();
+                bd.value_len = value.size();
+                bd.length = ValueTraits<value_t>::positive(bis[i].value)
+                    ? ValueTraits<value_t>::scale(bis[i].value, bis[0].value, bar_len) : 0;
+                bd.category = bis[i].category;
+                bd.climb = bis[i].climb;
+                bars.push_back(bd);
+            }
+            std::string axis = build_axis(fd.n_bars, bar_len, bis);
+            fd.axis = add_text(axis);
+            fd.axis_len = axis.size();
+            frames.push_back(fd);
+        }
+    }
+
+    bool FrameLayout::save(const std::string &file_name, const Key &key) const {
+        //* [1] A temporary file with a unique name, in the same directory (so the rename is atomic).
+        std::string tmp_name = file_name + ".XXXXXX";
+        int fd = ::mkstemp(&tmp_name[0]);
+        if (fd < 0) {
+            return false;
+        }
+        ::close(fd);
+        std::ofstream file(tmp_name, std::ios::binary | std::ios::trunc);
+        if (not file.is_open()) {
+            std::remove(tmp_name.c_str());
+            return false;
+        }
+        //* [2] The layout.
+        uint64_t sizes[4]{frames.size(), bars.size(), legend.size(), pool.size()};
+        file.write(LAYOUT_MAGIC, sizeof(LAYOUT_MAGIC));
+        file.write(reinterpret_cast<const char*>(&key), sizeof(key));
+        file.write(reinterpret_cast<const char*>(&meta), sizeof(meta));
+        file.write(reinterpret_cast<const char*>(sizes), sizeof(sizes));
+        file.write(reinterpret_cast<const char*>(frames.data()), frames.size() * sizeof(FrameDesc));
+        file.write(reinterpret_cast<const char*>(bars.data()), bars.size() * sizeof(BarDesc));
+        file.write(reinterpret_cast<const char*>(legend.data()), legend.size() * sizeof(LegendDesc));
+        file.write(pool.data(), pool.size());
+        file.close();
+        //* [3] Replace the cache, or don't leave a broken file behind.
+        if (file.fail() or std::rename(tmp_name.c_str(), file_name.c_str()) != 0) {
+            std::remove(tmp_name.c_str());
+            return false;
+        }
+        return true;
+    }
+
+    bool FrameLayout::load(const std::string &file_name, const Key &key) {
+        std::ifstream file(file_name, std::ios::binary);
+        if (not file.is_open()) {
+            return false;
+        }
+        char magic[sizeof(LAYOUT_MAGIC)];
+        Key file_key;
+        uint64_t sizes[4];
+        file.read(magic, sizeof(magic));
+        file.read(reinterpret_cast<char*>(&file_key), sizeof(file_key));
+        if (file.fail() or std::memcmp(magic, LAYOUT_MAGIC, sizeof(magic)) != 0
+            or std::memcmp(&file_key, &key, sizeof(key)) != 0) {
+            return false;
+        }
+        file.read(reinterpret_cast<char*>(&meta), sizeof(meta));
+        file.read(reinterpret_cast<char*>(sizes), sizeof(sizes));
+        if (file.fail()) {
+            return false;
+        }
+        //* The sections must fit in the rest of the file (before anything is allocated).
+        std::streamoff start = file.tellg();
+        file.seekg(0, std::ios::end);
+        uint64_t left = static_cast<uint64_t>(file.tellg() - start);
+        file.seekg(start);
+        const uint64_t item_sizes[4]{sizeof(FrameDesc), sizeof(BarDesc), sizeof(LegendDesc), 1};
+        for (size_t s{0}; s < 4; s++) {
+            if (sizes[s] > left / item_sizes[s]) {
+                return false;
+            }
+            left -= sizes[s] * item_sizes[s];
+        }
+        frames.resize(sizes[0]);
+        bars.resize(sizes[1]);
+        legend.resize(sizes[2]);
+        pool.resize(sizes[3]);
+        file.read(reinterpret_cast<char*>(frames.data()), frames.size() * sizeof(FrameDesc));
+        file.read(reinterpret_cast<char*>(bars.data()), bars.size() * sizeof(BarDesc));
+        file.read(reinterpret_cast<char*>(legend.data()), legend.size() * sizeof(LegendDesc));
+        file.read(pool.data(), pool.size());
+        return not file.fail() and is_consistent();
+    }
+
+    bool FrameLayout::in_pool(uint64_t offset, uint64_t len) const {
+        return offset <= pool.size() and len <= pool.size() - offset;
+    }
+
+    bool FrameLayout::is_consistent(void) const {
+        if (not in_pool(meta.title_line, meta.title_line_len) or meta.title_len > meta.title_line_len
+            or not in_pool(meta.label, meta.label_len) or not in_pool(meta.source, meta.source_len)
+            or legend.size() != meta.n_categories) {
+            return false;
+        }
+        for (const auto &fd : frames) {
+            if (fd.first_bar > bars.size() or fd.n_bars > bars.size() - fd.first_bar
+                or not in_pool(fd.timestamp, fd.timestamp_len) or not in_pool(fd.axis, fd.axis_len)
+                or not in_pool(fd.time, fd.time_len)) {
+                return false;
+            }
+        }
+        for (const auto &bd : bars) {
+            if (not in_pool(bd.text, uint64_t{bd.label_len} + bd.value_len) or bd.category >= meta.n_categories) {
+                return false;
+            }
+        }
+        for (const auto &ld : legend) {
+            if (not in_pool(ld.text, ld.len) or ld.category >= legend.size()) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    std::string_view FrameLayout::text(uint64_t offset, uint64_t len) const {
+        return std::string_view(pool).substr(offset, len);
+    }
+    const FrameLayout::FrameDesc& FrameLayout::get_frame(size_t index) const {
+        return frames[index];
+    }
+    std::string_view FrameLayout::get_time(size_t index) const {
+        return text(frames[index].time, frames[index].time_len);
+    }
+    const FrameLayout::BarDesc& FrameLayout::get_bar(size_t index) const {
+        return bars[index];
+    }
+    const std::vector<FrameLayout::LegendDesc>& FrameLayout::get_legend(void) const {
+        return legend;
+    }
+    size_t FrameLayout::get_n_frames(void) const {
+        return frames.size();
+    }
+    size_t FrameLayout::get_n_categories(void) const {
+        return meta.n_categories;
+    }
+    std::vector<std::string> FrameLayout::get_categories(void) const {
+        std::vector<std::string> categories(legend.size());
+        for (const auto &entry : legend) {
+            categories[entry.category] = text(entry.text, entry.len);
+        }
+        return categories;
+    }
+    size_t FrameLayout::get_n_skipped(void) const {
+        return meta.n_skipped;
+    }
+    std::string_view FrameLayout::get_title_line(void) const {
+        return text(meta.title_line, meta.title_line_len);
+    }
+    std::string_view FrameLayout::get_title(void) const {
+        return text(meta.title_line + meta.title_line_len - meta.title_len, meta.title_len);
+    }
+    std::string_view FrameLayout::get_label(void) const {
+        return text(meta.label, meta.label_len);
+    }
+    std::string_view FrameLayout::get_source_info(void) const {
+        return text(meta.source, meta.source_len);
+    }
+
+    //============[ End FrameLayout class ]===============//
+
+} // namespace bcr
@@ -0,0 +1,57 @@
+/*!
+ * @file frame_renderer.cpp
+ * @author João Guilherme Lopes Alves da Costa (joguicosta@hotmail.com)
+ * @brief Implementation of the frame renderer: picks the compiled renderer of a bar width and color depth.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#include <algorithm> ///< To use find.
+
+#include "frame_renderer.h"
+
+/*!
+ * @namespace bcr contains all the classes used in the bar chart race.
+ */
+namespace bcr {
+    /**
+     * @brief Create the renderer of a bar width for the color depth of the table.
+     */
+    template <size_t WIDTH>
+    static std::unique_ptr<FrameRenderer> create_width(const ColorTable &colors, size_t n_categories,
+                                                       const std::string &legend, bool overtakes) {
+        switch (colors.get_depth()) {
+            case ColorTable::EXTENDED:
+                return std::make_unique<BasicFrameRenderer<WIDTH, ColorTable::EXTENDED>>(colors, n_categories, legend, overtakes);
+            case ColorTable::TRUECOLOR:
+                return std::make_unique<BasicFrameRenderer<WIDTH, ColorTable::TRUECOLOR>>(colors, n_categories, legend, overtakes);
+            default:
+                return std::make_unique<BasicFrameRenderer<WIDTH, ColorTable::BASIC>>(colors, n_categories, legend, overtakes);
+        }
+    }
+
+    //============[ FrameRenderer METHODS ]===============//
+
+    std::unique_ptr<FrameRenderer> FrameRenderer::create(size_t width, const ColorTable &colors, size_t n_categories,
+                                                         const std::string &legend, bool overtakes) {
+        // One case for each of BAR_WIDTHS.
+        switch (width) {
+            case 30: return create_width<30>(colors, n_categories, legend, overtakes);
+            case 45: return create_width<45>(colors, n_categories, legend, overtakes);
+            case 60: return create_width<60>(colors, n_categories, legend, overtakes);
+            case 90: return create_width<90>(colors, n_categories, legend, overtakes);
+            case 120: return create_width<120>(colors, n_categories, legend, overtakes);
+        }
+        return nullptr;
+    }
+
+    bool FrameRenderer::supported(size_t width) {
+        return std::find(BAR_WIDTHS.begin(), BAR_WIDTHS.end(), width) != BAR_WIDTHS.end();
+    }
+
+    //============[ End FrameRenderer class ]===============//
+
+} // namespace bcr
@@ -0,0 +1,631 @@
+/*!
+ * @file input_source.cpp
+ * @author João Guilherme Lopes Alves da Costa (joguicosta@hotmail.com)
+ * @brief Implementation of the input source classes.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#include <algorithm> ///< To use min.
+#include <chrono> ///< To measure the time waiting for the data.
+#include <cerrno> ///< To check for interrupted reads.
+
+#include <fcntl.h> ///< To use open and posix_fadvise.
+#include <sys/mman.h> ///< To map the file into memory.
+#include <sys/resource.h> ///< To count the major page faults.
+#include <sys/stat.h> ///< To get the size and type of the file.
+#include <unistd.h> ///< To use pread, read and close.
+
+#ifdef BCR_HAVE_ZLIB
+#include <zlib.h> ///< To decompress gzip files.
+#endif
+#ifdef BCR_HAVE_ZSTD
+#include <zstd.h> ///< To decompress zstd files.
+#endif
+
+#include "input_source.h"
+
+/*!
+ * @namespace bcr contains all the classes used in the bar chart race.
+ */
+namespace bcr {
+    /**
+     * @brief Get the number of major page faults of the process until now.
+     */
+    static uint64_t major_faults(void) {
+        struct rusage usage;
+        ::getrusage(RUSAGE_SELF, &usage);
+        return usage.ru_majflt;
+    }
+
+    /**
+     * @brief Get the current time, in ns.
+     */
+    static uint64_t now_ns(void) {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    //============[ InputSource METHODS ]===============//
+
+    InputSource::InputSource(void) : start_faults{major_faults()} {}
+
+    bool InputSource::failed(void) const {
+        return error;
+    }
+
+    IoStats InputSource::get_stats(void) const {
+        IoStats res = stats;
+        res.major_faults = major_faults() - start_faults;
+        return res;
+    }
+
+    InputSource::Compression InputSource::get_compression(void) const {
+        return compression;
+    }
+
+    std::unique_ptr<InputSource> InputSource::open(const std::string &file_name, Mode mode, std::string &err) {
+        Compression compression = detect(file_name);
+        if (not supported(compression)) {
+            err = std::string("the file is compressed with ") + compression_name(compression)
+                + ", but this build can't decompress it";
+            return nullptr;
+        }
+        //* [1] The source of the bytes of the file.
+        std::unique_ptr<InputSource> raw;
+        if (mode == MMAP) {
+            std::unique_ptr<MappedSource> source{new MappedSource()};
+            if (source->open(file_name)) {
+                raw = std::move(source);
+            }
+        }
+        if (raw == nullptr) {
+            // Also used when the file can't be mapped.
+            std::unique_ptr<ReaderSource> source{new ReaderSource()};
+            if (not source->open(file_name)) {
+                err = "the file doesn't exist or can't be read";
+                return nullptr;
+            }
+            raw = std::move(source);
+        }
+        //* [2] Decompress them, if needed.
+        if (compression != NONE) {
+            return std::unique_ptr<InputSource>{new DecompressSource(std::move(raw), compression)};
+        }
+        return raw;
+    }
+
+    InputSource::Compression InputSource::detect(const std::string &file_name) {
+        int fd = ::open(file_name.c_str(), O_RDONLY);
+        struct stat st;
+        unsigned char magic[4]{};
+        ssize_t n{0};
+        if (fd >= 0 and ::fstat(fd, &st) == 0 and S_ISREG(st.st_mode)) {
+            n = ::pread(fd, magic, sizeof(magic), 0);
+        }
+        if (fd >= 0) {
+            ::close(fd);
+        }
+        if (n >= 2 and magic[0] == 0x1f and magic[1] == 0x8b) {
+            return GZIP;
+        }
+        if (n >= 4 and magic[0] == 0x28 and magic[1] == 0xb5 and magic[2] == 0x2f and magic[3] == 0xfd) {
+            return ZSTD;
+        }
+        return NONE;
+    }
+
+    bool InputSource::supported(Compression compression) {
+        switch (compression) {
+            case NONE: return true;
+#ifdef BCR_HAVE_ZLIB
+            case GZIP: return true;
+#endif
+#ifdef BCR_HAVE_ZSTD
+            case ZSTD: return true;
+#endif
+            default: return false;
+        }
+    }
+
+    const char* InputSource::compression_name(Compression compression) {
+        switch (compression) {
+            case NONE: return "none";
+            case GZIP: return "gzip";
+            case ZSTD: return "zstd";
+        }
+        return "unknown";
+    }
+
+    const char* InputSource::mode_name(Mode mode) {
+        return (mode == MMAP) ? "mmap" : "pread";
+    }
+
+    //============[ End InputSource class ]===============//
+
+    //============[ MappedSource METHODS ]===============//
+
+    MappedSource::~MappedSource(void) {
+        if (addr != nullptr) {
+            ::munmap(addr, length);
+        }
+    }
+
+    bool MappedSource::open(const std::string &file_name) {
+        int fd = ::open(file_name.c_str(), O_RDONLY);
+        struct stat st;
+        if (fd < 0) {
+            return false;
+        }
+        if (::fstat(fd, &st) != 0 or not S_ISREG(st.st_mode)) {
+            ::close(fd);
+            return false;
+        }
+        length = static_cast<size_t>(st.st_size);
+        if (length > 0) {
+            void *res = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (res == MAP_FAILED) {
+                ::close(fd);
+                return false;
+            }
+            addr = static_cast<char*>(res);
+            stats.mapped = true;
+            ::madvise(addr, length, MADV_SEQUENTIAL);
+        }
+        // The mapping keeps the file open.
+        ::close(fd);
+        return true;
+    }
+
+    bool MappedSource::next(Chunk &chunk) {
+        if (cursor >= length) {
+            return false;
+        }
+        size_t size = std::min(WINDOW, length - cursor);
+        //* [1] Ask the kernel to read ahead of the parser.
+        size_t ahead = std::min(length, cursor + size + AHEAD);
+        if (advised < ahead) {
+            size_t page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+            size_t begin = (advised / page) * page;
+            ::madvise(addr + begin, ahead - begin, MADV_WILLNEED);
+            advised = ahead;
+        }
+        //* [2] Touch each page of the window, so the parser doesn't stop on page faults.
+        // The time spent here is the time waiting for the disk.
+        uint64_t t0 = now_ns();
+        volatile char sink{0};
+        for (size_t i{0}; i < size; i += 4096) {
+            sink = sink + addr[cursor + i];
+        }
+        stats.wait_ns += now_ns() - t0;
+
+        chunk.data = addr + cursor;
+        chunk.size = size;
+        cursor += size;
+        stats.bytes += size;
+        stats.chunks++;
+        return true;
+    }
+
+    void MappedSource::will_need(void) {
+        if (addr != nullptr) {
+            ::madvise(addr, length, MADV_WILLNEED);
+            advised = length;
+        }
+    }
+
+    const char* MappedSource::data(void) const {
+        return addr;
+    }
+    size_t MappedSource::size(void) const {
+        return length;
+    }
+
+    //============[ End MappedSource class ]===============//
+
+    //============[ ChunkQueue METHODS ]===============//
+
+    ChunkQueue::ChunkQueue(size_t n_buffers, size_t buffer_size) : slots(n_buffers) {
+        for (auto &slot : slots) {
+            slot.buffer.reset(new char[buffer_size]);
+        }
+    }
+
+    void ChunkQueue::limit(size_t n_chunks) {
+        std::lock_guard<std::mutex> lock(mtx);
+        this->n_chunks = std::min(this->n_chunks, n_chunks);
+    }
+
+    bool ChunkQueue::claim(size_t &index, char *&buffer) {
+        std::unique_lock<std::mutex> lock(mtx);
+        cv_free.wait(lock, [this]() {
+            return stopped or next_index >= n_chunks or next_index < released + slots.size();
+        });
+        if (stopped or next_index >= n_chunks) {
+            return false;
+        }
+        index = next_index++;
+        buffer = slots[index % slots.size()].buffer.get();
+        return true;
+    }
+
+    void ChunkQueue::publish(size_t index, size_t size, bool last) {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            Slot &slot = slots[index % slots.size()];
+            slot.size = size;
+            slot.ready = true;
+            if (last) {
+                n_chunks = std::min(n_chunks, (size > 0) ? index + 1 : index);
+            }
+        }
+        cv_ready.notify_all();
+        cv_free.notify_all();
+    }
+
+    bool ChunkQueue::next(InputSource::Chunk &chunk, uint64_t &wait_ns) {
+        std::unique_lock<std::mutex> lock(mtx);
+        //* [1] Release the chunk given before.
+        if (cursor > released) {
+            slots[released % slots.size()].ready = false;
+            released++;
+            cv_free.notify_all();
+        }
+        //* [2] Wait for the next chunk.
+        Slot &slot = slots[cursor % slots.size()];
+        uint64_t t0 = now_ns();
+        cv_ready.wait(lock, [this, &slot]() {
+            return slot.ready or cursor >= n_chunks;
+        });
+        wait_ns += now_ns() - t0;
+        if (cursor >= n_chunks or slot.size == 0) {
+            return false;
+        }
+        chunk.data = slot.buffer.get();
+        chunk.size = slot.size;
+        cursor++;
+        return true;
+    }
+
+    void ChunkQueue::stop(void) {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            stopped = true;
+        }
+        cv_free.notify_all();
+    }
+
+    //============[ End ChunkQueue class ]===============//
+
+    //============[ ReaderSource METHODS ]===============//
+
+    ReaderSource::ReaderSource(size_t n_threads, size_t n_buffers)
+        : n_threads{n_threads}, n_buffers{n_buffers}, queue(n_buffers, CHUNK) {}
+
+    ReaderSource::~ReaderSource(void) {
+        queue.stop();
+        for (auto &reader : readers) {
+            reader.join();
+        }
+        if (fd >= 0) {
+            ::close(fd);
+        }
+    }
+
+    bool ReaderSource::open(const std::string &file_name) {
+        fd = ::open(file_name.c_str(), O_RDONLY);
+        struct stat st;
+        if (fd < 0 or ::fstat(fd, &st) != 0) {
+            return false;
+        }
+        seekable = S_ISREG(st.st_mode);
+        if (seekable) {
+            size_t file_size = static_cast<size_t>(st.st_size);
+            queue.limit((file_size + CHUNK - 1) / CHUNK);
+            ::posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+        }
+        else {
+            // A pipe must be read in order, by a single thread.
+            n_threads = 1;
+        }
+        for (size_t i{0}; i < n_threads; i++) {
+            readers.emplace_back(&ReaderSource::reader_loop, this);
+        }
+        return true;
+    }
+
+    void ReaderSource::reader_loop(void) {
+        size_t index;
+        char *buffer;
+        //* [1] Claim the next chunk, when its buffer is free.
+        while (queue.claim(index, buffer)) {
+            //* [2] Read it, asking the kernel to read the chunks after it too.
+            size_t total{0};
+            bool failed{false};
+            while (total < CHUNK) {
+                ssize_t n;
+                if (seekable) {
+                    n = ::pread(fd, buffer + total, CHUNK - total, index * CHUNK + total);
+                }
+                else {
+                    n = ::read(fd, buffer + total, CHUNK - total);
+                }
+                if (n < 0 and errno == EINTR) {
+                    continue;
+                }
+                if (n <= 0) {
+                    failed = n < 0;
+                    break;
+                }
+                total += n;
+            }
+            if (seekable) {
+                ::posix_fadvise(fd, (index + n_buffers) * CHUNK, CHUNK, POSIX_FADV_WILLNEED);
+            }
+
+            //* [3] Give it to the parser. The end of a pipe is the first chunk not filled.
+            if (failed) {
+                error = true;
+                queue.publish(index, 0, true);
+            }
+            else {
+                queue.publish(index, total, not seekable and total < CHUNK);
+            }
+        }
+    }
+
+    bool ReaderSource::next(Chunk &chunk) {
+        if (not queue.next(chunk, stats.wait_ns)) {
+            return false;
+        }
+        stats.bytes += chunk.size;
+        stats.chunks++;
+        return true;
+    }
+
+    //============[ End ReaderSource class ]===============//
+
+    //============[ DecompressSource METHODS ]===============//
+
+    //* The state of a decompression. decode() takes what it can from the input and fills the output,
+    // moving both forward, and returns false if the data is corrupt.
+    struct DecompressSource::Decoder {
+        virtual ~Decoder(void) = default;
+        virtual bool decode(const char *&in, size_t &in_left, char *&out, size_t &out_left) = 0;
+        bool finished{false}; //!< If the last frame (or gzip member) is complete, so the input may end here.
+    };
+
+#ifdef BCR_HAVE_ZLIB
+    //* gzip decompression with zlib (the files may have several members, as `cat a.gz b.gz`).
+    struct GzipDecoder : DecompressSource::Decoder {
+        z_stream zs{};
+        bool ready{false};
+
+        GzipDecoder(void) {
+            // 15 + 32: the largest window, with automatic detection of the gzip or zlib header.
+            ready = ::inflateInit2(&zs, 15 + 32) == Z_OK;
+        }
+        ~GzipDecoder(void) {
+            if (ready) {
+                ::inflateEnd(&zs);
+            }
+        }
+        bool decode(const char *&in, size_t &in_left, char *&out, size_t &out_left) override {
+            if (not ready) {
+                return false;
+            }
+            // A new member begins after the end of the last one.
+            if (finished and in_left > 0) {
+                ::inflateReset(&zs);
+                finished = false;
+            }
+            zs.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(in));
+            zs.avail_in = static_cast<uInt>(std::min<size_t>(in_left, UINT32_MAX));
+            zs.next_out = reinterpret_cast<Bytef*>(out);
+            zs.avail_out = static_cast<uInt>(std::min<size_t>(out_left, UINT32_MAX));
+            uInt in_given = zs.avail_in, out_given = zs.avail_out;
+            int ret = ::inflate(&zs, Z_NO_FLUSH);
+            in += in_given - zs.avail_in;
+            in_left -= in_given - zs.avail_in;
+            out += out_given - zs.avail_out;
+            out_left -= out_given - zs.avail_out;
+            if (ret == Z_STREAM_END) {
+                finished = true;
+                return true;
+            }
+            // Z_BUF_ERROR only means that no progress was possible (more input is needed).
+            return ret == Z_OK or ret == Z_BUF_ERROR;
+        }
+    };
+#endif
+
+#ifdef BCR_HAVE_ZSTD
+    //* zstd decompression (the stream goes on by itself through several frames).
+    struct ZstdDecoder : DecompressSource::Decoder {
+        ZSTD_DStream *zds{::ZSTD_createDStream()};
+
+        ZstdDecoder(void) {
+            if (zds != nullptr) {
+                ::ZSTD_initDStream(zds);
+            }
+        }
+        ~ZstdDecoder(void) {
+            ::ZSTD_freeDStream(zds);
+        }
+        bool decode(const char *&in, size_t &in_left, char *&out, size_t &out_left) override {
+            if (zds == nullptr) {
+                return false;
+            }
+            ZSTD_inBuffer input{in, in_left, 0};
+            ZSTD_outBuffer output{out, out_left, 0};
+            size_t ret = ::ZSTD_decompressStream(zds, &output, &input);
+            if (::ZSTD_isError(ret)) {
+                return false;
+            }
+            in += input.pos;
+            in_left -= input.pos;
+            out += output.pos;
+            out_left -= output.pos;
+            // 0 means that a frame ended and all its bytes were given.
+            if (ret == 0) {
+                finished = true;
+            }
+            else if (input.pos > 0 or output.pos > 0) {
+                finished = false;
+            }
+            return true;
+        }
+    };
+#endif
+
+    DecompressSource::DecompressSource(std::unique_ptr<InputSource> raw, Compression compression, size_t n_buffers)
+        : raw{std::move(raw)}, queue(n_buffers, CHUNK) {
+        this->compression = compression;
+        stats.mapped = this->raw->get_stats().mapped;
+#ifdef BCR_HAVE_ZLIB
+        if (compression == GZIP) {
+            decoder.reset(new GzipDecoder());
+        }
+#endif
+#ifdef BCR_HAVE_ZSTD
+        if (compression == ZSTD) {
+            decoder.reset(new ZstdDecoder());
+        }
+#endif
+        worker = std::thread(&DecompressSource::decoder_loop, this);
+    }
+
+    DecompressSource::~DecompressSource(void) {
+        queue.stop();
+        worker.join();
+    }
+
+    void DecompressSource::decoder_loop(void) {
+        Chunk in;
+        const char *in_ptr{nullptr};
+        size_t in_left{0};
+        bool in_done{false};
+        size_t index;
+        char *buffer;
+        //* [1] Wait for a free buffer.
+        while (queue.claim(index, buffer)) {
+            //* [2] Fill it with the next decompressed bytes, reading the compressed ones as needed.
+            size_t total{0};
+            bool end{false}, failed{decoder == nullptr};
+            while (total < CHUNK and not end and not failed) {
+                if (in_left == 0 and not in_done) {
+                    if (raw->next(in)) {
+                        in_ptr = in.data;
+                        in_left = in.size;
+                        stats.compressed_bytes += in.size;
+                    }
+                    else {
+                        in_done = true;
+                        failed = raw->failed();
+                    }
+                }
+                char *out = buffer + total;
+                size_t out_left = CHUNK - total;
+                size_t in_before = in_left;
+                if (not decoder->decode(in_ptr, in_left, out, out_left)) {
+                    failed = true;
+                    break;
+                }
+                size_t produced = (CHUNK - total) - out_left;
+                total += produced;
+                if (produced == 0 and in_left == in_before) {
+                    if (in_done) {
+                        // The file must not end in the middle of a frame.
+                        end = true;
+                        failed = not decoder->finished;
+                    }
+                    else if (in_left > 0) {
+                        // Bytes that can't be decompressed (e.g. garbage after the last frame).
+                        failed = true;
+                    }
+                }
+            }
+
+            //* [3] Give it to the parser.
+            if (failed) {
+                error = true;
+            }
+            queue.publish(index, total, end or failed);
+            if (end or failed) {
+                break;
+            }
+        }
+    }
+
+    bool DecompressSource::next(Chunk &chunk) {
+        if (not queue.next(chunk, stats.wait_ns)) {
+            return false;
+        }
+        stats.bytes += chunk.size;
+        stats.chunks++;
+        return true;
+    }
+
+    //============[ End DecompressSource class ]===============//
+
+    //============[ LineReader METHODS ]===============//
+
+    LineReader::LineReader(InputSource &source) : source{source} {}
+
+    bool LineReader::next(std::string_view &line) {
+        carry.clear();
+        commas.clear();
+        bool has_carry{false};
+        while (true) {
+            if (pos >= chunk.size) {
+                if (done or not source.next(chunk)) {
+                    done = true;
+                    // The last line may not end with '\n' (but it's cut if the reading failed).
+                    line = carry;
+                    return has_carry and not source.failed();
+                }
+                pos = 0;
+                indexer.index(chunk.data, chunk.size, structurals);
+                next_struct = 0;
+            }
+            const char *begin = chunk.data + pos;
+            // The bytes of the line in the chunks before this one.
+            size_t before = carry.size();
+            while (next_struct < structurals.size()) {
+                size_t at = structurals[next_struct++];
+                if (chunk.data[at] == ',') {
+                    commas.push_back(static_cast<uint32_t>(before + at - pos));
+                    continue;
+                }
+                size_t len = at - pos;
+                pos = at + 1;
+                if (has_carry) {
+                    carry.append(begin, len);
+                    line = carry;
+                }
+                else {
+                    line = std::string_view(begin, len);
+                }
+                return true;
+            }
+            // The line continues in the next chunk.
+            carry.append(begin, chunk.size - pos);
+            has_carry = true;
+            pos = chunk.size;
+        }
+    }
+
+    const std::vector<uint32_t>& LineReader::get_commas(void) const {
+        return commas;
+    }
+
+    const StructIndexer& LineReader::get_indexer(void) const {
+        return indexer;
+    }
+
+    //============[ End LineReader class ]===============//
+
+} // namespace bcr
@@ -0,0 +1,113 @@
+/*!
+ * @file ranker.cpp
+ * @author João Guilherme Lopes Alves da Costa (joguicosta@hotmail.com)
+ * @brief Implementation of the ranker.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#include <algorithm> ///< To use stable_sort and merge.
+#include <iterator> ///< To use back_inserter.
+
+#include "ranker.h"
+
+/*!
+ * @namespace bcr contains all the classes used in the bar chart race.
+ */
+namespace bcr {
+    //============[ Ranker METHODS ]===============//
+
+    void Ranker::rank(std::vector<BarChart::BarItem> &bars) {
+        auto higher = [&bars](uint32_t a, uint32_t b) { return bars[b].value < bars[a].value; };
+        n_charts++;
+
+        //* [1] Start from the order of the previous chart: its labels in their positions, then the new ones.
+        slots.assign(prev_size, -1);
+        newcomers.clear();
+        for (uint32_t i{0}; i < bars.size(); i++) {
+            auto it = ranks.find(bars[i].label);
+            if (it != ranks.end() and it->second.chart + 1 == n_charts and slots[it->second.position] < 0) {
+                slots[it->second.position] = static_cast<int32_t>(i);
+            }
+            else {
+                newcomers.push_back(i);
+            }
+        }
+        known.clear();
+        seed.assign(bars.size(), -1);
+        for (int32_t slot : slots) {
+            if (slot >= 0) {
+                seed[slot] = static_cast<int32_t>(known.size());
+                known.push_back(static_cast<uint32_t>(slot));
+            }
+        }
+
+        //* [2] Repair the order of the known labels with an insertion sort: each move is an overtake.
+        // If the chart is too different from the previous one, it's sorted from scratch.
+        size_t budget = MAX_MOVES_PER_BAR * known.size();
+        size_t n_moves{0};
+        bool repaired{true};
+        for (size_t k{1}; k < known.size() and repaired; k++) {
+            uint32_t bar = known[k];
+            size_t j = k;
+            while (j > 0 and higher(bar, known[j - 1])) {
+                if (n_moves == budget) {
+                    repaired = false;
+                    break;
+                }
+                n_moves++;
+                known[j] = known[j - 1];
+                j--;
+            }
+            known[j] = bar;
+        }
+        if (not repaired) {
+            std::stable_sort(known.begin(), known.end(), higher);
+        }
+        if (repaired and not known.empty()) {
+            n_repaired++;
+            n_overtakes += n_moves;
+        }
+        else {
+            n_resorted++;
+        }
+
+        //* [3] The new labels are sorted apart, and go after the known ones with the same value.
+        std::stable_sort(newcomers.begin(), newcomers.end(), higher);
+        order.clear();
+        std::merge(known.begin(), known.end(), newcomers.begin(), newcomers.end(), std::back_inserter(order), higher);
+
+        //* [4] Put the bars in order, with the places each one gained among the known labels.
+        sorted.clear();
+        int32_t known_rank{0};
+        for (uint32_t bar : order) {
+            bars[bar].climb = (seed[bar] < 0) ? 0 : seed[bar] - known_rank++;
+            sorted.push_back(std::move(bars[bar]));
+        }
+        bars.swap(sorted);
+
+        //* [5] Keep the ranking for the next chart.
+        for (uint32_t p{0}; p < bars.size(); p++) {
+            ranks[bars[p].label] = Rank{n_charts, p};
+        }
+        prev_size = bars.size();
+    }
+
+    size_t Ranker::get_n_repaired(void) const {
+        return n_repaired;
+    }
+
+    size_t Ranker::get_n_resorted(void) const {
+        return n_resorted;
+    }
+
+    uint64_t Ranker::get_n_overtakes(void) const {
+        return n_overtakes;
+    }
+
+    //============[ End Ranker class ]===============//
+
+} // namespace bcr
@@ -0,0 +1,154 @@
+/*!
+ * @file struct_indexer.cpp
+ * @author João Guilherme Lopes Alves da Costa (joguicosta@hotmail.com)
+ * @brief Implementation of the structural indexer.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#include <cstring> ///< To use memcpy.
+
+#if defined(__x86_64__) || defined(__i386__)
+#define BCR_X86
+#include <immintrin.h> ///< The SSE and AVX2 intrinsics.
+#endif
+
+#include "struct_indexer.h"
+
+/*!
+ * @namespace bcr contains all the classes used in the bar chart race.
+ */
+namespace bcr {
+    /**
+     * @brief Index a block one byte at a time.
+     */
+    static StructIndexer::Bitmaps block_scalar(const char *block) {
+        StructIndexer::Bitmaps res;
+        for (size_t i{0}; i < StructIndexer::BLOCK; i++) {
+            res.newlines |= static_cast<uint64_t>(block[i] == '\n') << i;
+            res.commas |= static_cast<uint64_t>(block[i] == ',') << i;
+        }
+        return res;
+    }
+
+#ifdef BCR_X86
+    /**
+     * @brief Index a block with four 16 bytes comparisons per character.
+     * These functions are compiled for their instruction set only, and called only when the CPU supports it.
+     */
+    __attribute__((target("sse4.2")))
+    static StructIndexer::Bitmaps block_sse42(const char *block) {
+        const __m128i newline = _mm_set1_epi8('\n');
+        const __m128i comma = _mm_set1_epi8(',');
+        StructIndexer::Bitmaps res;
+        for (size_t i{0}; i < StructIndexer::BLOCK; i += 16) {
+            __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + i));
+            uint64_t nl = static_cast<uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, newline)));
+            uint64_t cm = static_cast<uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, comma)));
+            res.newlines |= nl << i;
+            res.commas |= cm << i;
+        }
+        return res;
+    }
+
+    /**
+     * @brief Index a block with two 32 bytes comparisons per character.
+     */
+    __attribute__((target("avx2")))
+    static StructIndexer::Bitmaps block_avx2(const char *block) {
+        const __m256i newline = _mm256_set1_epi8('\n');
+        const __m256i comma = _mm256_set1_epi8(',');
+        __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block));
+        __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 32));
+        StructIndexer::Bitmaps res;
+        res.newlines = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, newline)))
+            | static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, newline)))) << 32;
+        res.commas = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, comma)))
+            | static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, comma)))) << 32;
+        return res;
+    }
+#endif
+
+    //============[ StructIndexer METHODS ]===============//
+
+    StructIndexer::StructIndexer(Isa isa) : isa{isa}, block_func{block_scalar} {
+#ifdef BCR_X86
+        if (isa == SSE42) {
+            block_func = block_sse42;
+        }
+        else if (isa == AVX2) {
+            block_func = block_avx2;
+        }
+#else
+        this->isa = SCALAR;
+#endif
+    }
+
+    StructIndexer::Bitmaps StructIndexer::index_block(const char *block) const {
+        return block_func(block);
+    }
+
+    void StructIndexer::index(const char *data, size_t size, std::vector<uint32_t> &positions) const {
+        positions.clear();
+        // Turn the bits of a block into offsets.
+        auto flatten = [&positions](uint64_t bits, size_t base) {
+            while (bits != 0) {
+                positions.push_back(static_cast<uint32_t>(base + __builtin_ctzll(bits)));
+                bits &= bits - 1;
+            }
+        };
+        size_t i{0};
+        for (; i + BLOCK <= size; i += BLOCK) {
+            Bitmaps bm = block_func(data + i);
+            flatten(bm.newlines | bm.commas, i);
+        }
+        //* The last bytes are copied to a block padded with zeros.
+        if (i < size) {
+            char tail[BLOCK]{};
+            std::memcpy(tail, data + i, size - i);
+            Bitmaps bm = block_func(tail);
+            flatten(bm.newlines | bm.commas, i);
+        }
+    }
+
+    StructIndexer::Isa StructIndexer::get_isa(void) const {
+        return isa;
+    }
+
+    StructIndexer::Isa StructIndexer::best(void) {
+        if (supported(AVX2)) {
+            return AVX2;
+        }
+        if (supported(SSE42)) {
+            return SSE42;
+        }
+        return SCALAR;
+    }
+
+    bool StructIndexer::supported(Isa isa) {
+#ifdef BCR_X86
+        if (isa == AVX2) {
+            return __builtin_cpu_supports("avx2");
+        }
+        if (isa == SSE42) {
+            return __builtin_cpu_supports("sse4.2");
+        }
+#endif
+        return isa == SCALAR;
+    }
+
+    const char* StructIndexer::isa_name(Isa isa) {
+        switch (isa) {
+            case SCALAR: return "scalar";
+            case SSE42: return "sse4.2";
+            case AVX2: return "avx2";
+        }
+        return "unknown";
+    }
+
+    //============[ End StructIndexer class ]===============//
+
+} // namespace bcr
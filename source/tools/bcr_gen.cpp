@@ -0,0 +1,252 @@
+/*!
+ * @file bcr_gen.cpp
+ * @author João Guilherme Lopes Alves da Costa (joguicosta@hotmail.com)
+ * @brief Generates synthetic data files for the bar chart race, to test it with large inputs.
+ * The same options (and seed) always give the same file, on any platform.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#include <algorithm> ///< To use min and swap.
+#include <cmath> ///< To use pow.
+#include <cstdint> ///< To use uint64_t.
+#include <cstdlib> ///< EXIT_SUCCESS and EXIT_FAILURE.
+#include <fstream> ///< To write the data file.
+#include <iostream> ///< To use cout and cerr.
+#include <numeric> ///< To use iota.
+#include <string> ///< To use string ans its methods.
+#include <vector> ///< To use vector and its methods.
+
+//* Struct with the options of the generator.
+struct GenOpt {
+    size_t n_charts{1000}; //!< Number of charts.
+    size_t n_bars{20}; //!< Number of bars of each chart.
+    size_t n_labels{100}; //!< Number of different labels (at least n_bars).
+    size_t n_categories{10}; //!< Number of different categories.
+    std::string dist{"walk"}; //!< Distribution of the values: walk, uniform or pareto.
+    uint64_t max_value{1000000}; //!< The highest value.
+    double corrupt{0}; //!< Fraction of the charts with an injected error.
+    uint64_t seed{1}; //!< Seed of the random numbers.
+    std::string out_filename; //!< The data file (stdout if empty).
+};
+
+//* A small random generator (splitmix64) whose numbers are the same in every platform,
+// unlike the distributions of <random>.
+class Random {
+    public:
+        Random(uint64_t seed) : state{seed} {}
+
+        //* The next 64 random bits.
+        uint64_t next(void) {
+            uint64_t z = (state += 0x9e3779b97f4a7c15ull);
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+            return z ^ (z >> 31);
+        }
+        //* A number in [0, n).
+        uint64_t below(uint64_t n) {
+            return static_cast<uint64_t>((static_cast<unsigned __int128>(next()) * n) >> 64);
+        }
+        //* A number in [0, 1).
+        double real(void) {
+            return (next() >> 11) * (1.0 / (1ull << 53));
+        }
+
+    private:
+        uint64_t state; ///< The state of the generator.
+};
+
+/**
+ * @brief Prints out the syntax of the generator and the error message, and ends the program.
+ */
+static void usage(const std::string &error) {
+    if (not error.empty()) {
+        std::cerr << error << "\n\n";
+    }
+    std::cerr << "Usage: bcr_gen [<options>]\n"
+              << "  Generator options:\n"
+              << "    -o <file>           Write to this file (default: stdout).\n"
+              << "    --charts <num>      Number of charts. Default is 1000.\n"
+              << "    --bars <num>        Number of bars of each chart. Default is 20.\n"
+              << "    --labels <num>      Number of different labels (at least the bars). Default is 100.\n"
+              << "    --categories <num>  Number of different categories. Default is 10.\n"
+              << "    --dist <name>       Distribution of the values: walk (each label grows or shrinks\n"
+              << "                        a little in each chart), uniform or pareto. Default is walk.\n"
+              << "    --max <num>         The highest value. Default is 1000000.\n"
+              << "    --corrupt <frac>    Fraction of the charts with one injected error (bad value,\n"
+              << "                        missing field, empty label, wrong count). Default is 0.\n"
+              << "    --seed <num>        Seed of the random numbers. Default is 1.\n";
+    exit(error.empty() ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+
+/**
+ * @brief Read the options of the command line.
+ */
+static GenOpt parse_args(int argc, char *argv[]) {
+    GenOpt opt;
+    for (int i{1}; i < argc; i++) {
+        std::string str(argv[i]);
+        if (str == "-h" or str == "--help") {
+            usage("");
+        }
+        if (i + 1 >= argc) {
+            usage(">>> ERROR! The option \"" + str + "\" needs a value.");
+        }
+        std::string value(argv[++i]);
+        try {
+            if (str == "-o") {
+                opt.out_filename = value;
+            }
+            else if (str == "--charts") {
+                opt.n_charts = std::stoull(value);
+            }
+            else if (str == "--bars") {
+                opt.n_bars = std::stoull(value);
+            }
+            else if (str == "--labels") {
+                opt.n_labels = std::stoull(value);
+            }
+            else if (str == "--categories") {
+                opt.n_categories = std::stoull(value);
+            }
+            else if (str == "--dist") {
+                opt.dist = value;
+            }
+            else if (str == "--max") {
+                opt.max_value = std::stoull(value);
+            }
+            else if (str == "--corrupt") {
+                opt.corrupt = std::stod(value);
+            }
+            else if (str == "--seed") {
+                opt.seed = std::stoull(value);
+            }
+            else {
+                usage(">>> ERROR! Unknown option \"" + str + "\".");
+            }
+        }
+        catch (const std::exception &e) {
+            usage(">>> ERROR! The value of \"" + str + "\" is invalid.");
+        }
+    }
+    if (opt.n_bars < 1 or opt.n_categories < 1 or opt.max_value < 1) {
+        usage(">>> ERROR! The bars, categories and max value must be at least 1.");
+    }
+    if (opt.dist != "walk" and opt.dist != "uniform" and opt.dist != "pareto") {
+        usage(">>> ERROR! The distribution must be walk, uniform or pareto.");
+    }
+    if (opt.corrupt < 0 or opt.corrupt > 1) {
+        usage(">>> ERROR! The corrupt fraction must be in [0,1].");
+    }
+    opt.n_labels = std::max(opt.n_labels, opt.n_bars);
+    return opt;
+}
+
+int main(int argc, char *argv[]) {
+    GenOpt opt = parse_args(argc, argv);
+    Random rng(opt.seed);
+
+    std::ofstream out_file;
+    if (not opt.out_filename.empty()) {
+        out_file.open(opt.out_filename, std::ios::binary);
+        if (not out_file.is_open()) {
+            usage(">>> ERROR! We couldn't create the file \"" + opt.out_filename + "\".");
+        }
+    }
+    std::ostream &out = opt.out_filename.empty() ? std::cout : out_file;
+
+    //* [1] The labels: each one has a fixed category and info, and a value that changes over time.
+    std::vector<std::string> labels(opt.n_labels);
+    std::vector<std::string> infos(opt.n_labels); ///< The other related info of each label.
+    std::vector<double> values(opt.n_labels); ///< The value of each label.
+    for (size_t i{0}; i < opt.n_labels; i++) {
+        labels[i] = "Label " + std::to_string(i + 1);
+        infos[i] = "Region " + std::to_string(i % 37 + 1);
+        values[i] = static_cast<double>(1 + rng.below(opt.max_value / 2 + 1));
+    }
+    std::vector<std::string> categories(opt.n_categories);
+    for (size_t i{0}; i < opt.n_categories; i++) {
+        categories[i] = "Category " + std::to_string(i + 1);
+    }
+    std::vector<uint32_t> category_of(opt.n_labels);
+    for (auto &c : category_of) {
+        c = static_cast<uint32_t>(rng.below(opt.n_categories));
+    }
+
+    //* [2] The header of the file.
+    std::string buf;
+    buf.reserve(1 << 21);
+    buf += "Synthetic bar chart race (" + std::to_string(opt.n_charts) + " charts, " + std::to_string(opt.n_bars)
+        + " bars, seed " + std::to_string(opt.seed) + ")\nValue\nSource: bcr_gen\n";
+
+    //* [3] The charts. Each one shows a random subset of the labels, with the time stamp 1, 2, 3...
+    std::vector<uint32_t> pick(opt.n_labels);
+    std::iota(pick.begin(), pick.end(), 0);
+    size_t n_corrupt{0};
+    // The chance of an error in millionths, so the draw is the same in every platform.
+    uint64_t corrupt_ppm = static_cast<uint64_t>(opt.corrupt * 1e6);
+    const double max_value = static_cast<double>(opt.max_value); ///< The highest value, rounded up.
+    for (size_t chart{0}; chart < opt.n_charts; chart++) {
+        // Choose the kind of error of this chart (0 is none).
+        int error = rng.below(1000000) < corrupt_ppm ? 1 + static_cast<int>(rng.below(4)) : 0;
+        size_t error_bar = rng.below(opt.n_bars);
+        n_corrupt += error != 0;
+
+        size_t count = opt.n_bars + (error == 4 ? 1 : 0); ///< A wrong count: the chart is one bar short.
+        buf += "\n" + std::to_string(count) + "\n";
+        std::string time = std::to_string(chart + 1);
+        // A partial Fisher-Yates shuffle takes n_bars different labels.
+        for (size_t i{0}; i < opt.n_bars; i++) {
+            std::swap(pick[i], pick[i + rng.below(opt.n_labels - i)]);
+        }
+        for (size_t i{0}; i < opt.n_bars; i++) {
+            uint32_t id = pick[i];
+            if (opt.dist == "walk") {
+                // A step of -5% to +6%, so the values grow slowly.
+                values[id] = std::max(1.0, values[id] * (0.95 + 0.11 * rng.real()));
+                values[id] = std::min(values[id], max_value);
+            }
+            else if (opt.dist == "uniform") {
+                values[id] = static_cast<double>(1 + rng.below(opt.max_value));
+            }
+            else {
+                // Pareto with alpha 1.16 (the 80/20 rule): most values are small, a few are huge.
+                values[id] = std::min(max_value, std::pow(1 - rng.real(), -1 / 1.16) * max_value / 1000);
+            }
+            // A max near 2^64 is rounded up as a double, so the highest values are cut to the max.
+            std::string value = std::to_string(values[id] < max_value ? static_cast<uint64_t>(values[id]) : opt.max_value);
+            const std::string &label = labels[id];
+            if (error != 0 and i == error_bar) {
+                if (error == 1) {
+                    value += "x";
+                }
+                else if (error == 2) {
+                    buf += time + "," + label + "," + value + "," + categories[category_of[id]] + "\n";
+                    continue;
+                }
+                else if (error == 3) {
+                    buf += time + ",," + infos[id] + "," + value + "," + categories[category_of[id]] + "\n";
+                    continue;
+                }
+            }
+            buf += time + "," + label + "," + infos[id] + "," + value + "," + categories[category_of[id]] + "\n";
+        }
+        if (buf.size() >= (1 << 20)) {
+            out.write(buf.data(), buf.size());
+            buf.clear();
+        }
+    }
+    out.write(buf.data(), buf.size());
+    out.flush();
+    if (not out) {
+        std::cerr << ">>> ERROR! We couldn't write the data file.\n";
+        return EXIT_FAILURE;
+    }
+    if (n_corrupt > 0) {
+        std::cerr << ">>> " << n_corrupt << " corrupt charts generated.\n";
+    }
+    return EXIT_SUCCESS;
+}
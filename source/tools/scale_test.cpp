@@ -0,0 +1,227 @@
+/*!
+ * @file scale_test.cpp
+ * @author João Guilherme Lopes Alves da Costa (joguicosta@hotmail.com)
+ * @brief Runs the bar chart race (headless) over a grid of generated data files and
+ * reports how the load time, the render time and the memory grow with the size.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#include <algorithm> ///< To use max.
+#include <chrono> ///< To measure the time.
+#include <cmath> ///< To use log.
+#include <cstdio> ///< To use remove.
+#include <cstdlib> ///< EXIT_SUCCESS and EXIT_FAILURE.
+#include <iomanip> ///< To use setw and setprecision.
+#include <iostream> ///< To use cout and cerr.
+#include <sstream> ///< To split the lists of sizes.
+#include <string> ///< To use string ans its methods.
+#include <vector> ///< To use vector and its methods.
+
+#include <fcntl.h> ///< To use open.
+#include <sys/resource.h> ///< To get the memory used by each run.
+#include <sys/stat.h> ///< To get the size of the data files.
+#include <sys/wait.h> ///< To use wait4.
+#include <unistd.h> ///< To use fork, exec and pipe.
+
+//* Struct with the result of one run of the grid.
+struct Result {
+    size_t n_charts{0}; //!< Number of charts of the data file.
+    size_t n_bars{0}; //!< Number of bars of each chart.
+    double file_mb{0}; //!< Size of the data file (MB).
+    double load_ms{0}; //!< Time reading the file and building the layout.
+    double render_ms{0}; //!< Time drawing every chart.
+    size_t frames{0}; //!< Number of charts drawn.
+    double wall_ms{0}; //!< Time of the whole run.
+    double rss_mb{0}; //!< The most memory used at once (MB).
+    bool ok{false}; //!< If the run worked.
+};
+
+/**
+ * @brief Run a program and wait for it.
+ * @param args The program and its arguments.
+ * @param err_output Where the standard error of the program will be stored (its standard output is discarded).
+ * @param usage Where the resources used by the program will be stored.
+ * @return true if the program ended with success.
+ * @return false otherwise.
+ */
+static bool run(const std::vector<std::string> &args, std::string &err_output, struct rusage &usage) {
+    int fds[2];
+    if (::pipe(fds) != 0) {
+        return false;
+    }
+    pid_t pid = ::fork();
+    if (pid < 0) {
+        return false;
+    }
+    if (pid == 0) {
+        int null_fd = ::open("/dev/null", O_RDWR);
+        ::dup2(null_fd, STDIN_FILENO);
+        ::dup2(null_fd, STDOUT_FILENO);
+        ::dup2(fds[1], STDERR_FILENO);
+        ::close(fds[0]);
+        std::vector<char*> argv;
+        for (const auto &arg : args) {
+            argv.push_back(const_cast<char*>(arg.c_str()));
+        }
+        argv.push_back(nullptr);
+        ::execv(argv[0], argv.data());
+        ::_exit(127);
+    }
+    ::close(fds[1]);
+    char buf[4096];
+    ssize_t n;
+    err_output.clear();
+    while ((n = ::read(fds[0], buf, sizeof(buf))) > 0) {
+        err_output.append(buf, n);
+    }
+    ::close(fds[0]);
+    int status{0};
+    ::wait4(pid, &status, 0, &usage);
+    return WIFEXITED(status) and WEXITSTATUS(status) == 0;
+}
+
+/**
+ * @brief Read a value "<key>=<number>" from the output of a run.
+ */
+static double field(const std::string &text, const std::string &key) {
+    size_t pos = text.find(key + "=");
+    return (pos == std::string::npos) ? 0 : std::stod(text.substr(pos + key.size() + 1));
+}
+
+/**
+ * @brief Read a list of sizes separated by commas (e.g. "1000,10000").
+ */
+static std::vector<size_t> parse_list(const std::string &str) {
+    std::vector<size_t> list;
+    std::istringstream ss(str);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        list.push_back(std::stoull(item));
+    }
+    return list;
+}
+
+/**
+ * @brief Prints out how fast a measure grows with the number of records, between the first and the last run of each bar count.
+ */
+static void report_growth(const std::vector<Result> &results, const std::string &name, double Result::*measure) {
+    std::cout << "  " << std::left << std::setw(10) << name << std::right;
+    for (size_t i{0}; i < results.size(); i++) {
+        // The last run with the same number of bars.
+        size_t j = i;
+        while (j + 1 < results.size() and results[j + 1].n_bars == results[i].n_bars) {
+            j++;
+        }
+        const Result &a = results[i], &b = results[j];
+        if (j > i and a.ok and b.ok and a.*measure > 0 and b.*measure > 0) {
+            double exponent = std::log(b.*measure / a.*measure)
+                / std::log(static_cast<double>(b.n_charts) / a.n_charts);
+            std::cout << "  bars=" << a.n_bars << ": ~records^" << std::setprecision(2) << exponent;
+        }
+        i = j;
+    }
+    std::cout << "\n";
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 3) {
+        std::cerr << "Usage: scale_test <bcr> <bcr_gen> [--charts <n,n,...>] [--bars <n,n,...>]\n"
+                  << "                  [--max-records <num>] [--dir <dir>] [--keep]\n";
+        return EXIT_FAILURE;
+    }
+    std::string bcr(argv[1]), gen(argv[2]), dir{"."};
+    std::vector<size_t> charts{1000, 10000, 100000}, bars{10, 100, 1000};
+    size_t max_records{10000000};
+    bool keep{false};
+    for (int i{3}; i < argc; i++) {
+        std::string str(argv[i]);
+        if (str == "--keep") {
+            keep = true;
+        }
+        else if (i + 1 < argc and str == "--charts") {
+            charts = parse_list(argv[++i]);
+        }
+        else if (i + 1 < argc and str == "--bars") {
+            bars = parse_list(argv[++i]);
+        }
+        else if (i + 1 < argc and str == "--max-records") {
+            max_records = std::stoull(argv[++i]);
+        }
+        else if (i + 1 < argc and str == "--dir") {
+            dir = argv[++i];
+        }
+        else {
+            std::cerr << ">>> ERROR! Unknown option \"" << str << "\".\n";
+            return EXIT_FAILURE;
+        }
+    }
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << std::setw(8) << "charts" << std::setw(7) << "bars" << std::setw(11) << "records"
+              << std::setw(10) << "file MB" << std::setw(11) << "load ms" << std::setw(11) << "render ms"
+              << std::setw(11) << "wall ms" << std::setw(10) << "RSS MB" << std::setw(12) << "ns/record"
+              << std::setw(10) << "B/record" << "\n";
+
+    //* [1] Generate each data file of the grid, run it and measure it.
+    std::vector<Result> results;
+    for (size_t n_bars : bars) {
+        for (size_t n_charts : charts) {
+            if (n_charts * n_bars > max_records) {
+                continue;
+            }
+            Result res;
+            res.n_charts = n_charts;
+            res.n_bars = n_bars;
+            std::string file = dir + "/scale_" + std::to_string(n_charts) + "x" + std::to_string(n_bars) + ".txt";
+            std::string output;
+            struct rusage usage;
+            bool generated = run({gen, "--charts", std::to_string(n_charts), "--bars", std::to_string(n_bars),
+                                  "--labels", std::to_string(std::max<size_t>(n_bars * 4, 100)),
+                                  "--categories", "50", "-o", file}, output, usage);
+            struct stat st;
+            if (generated and ::stat(file.c_str(), &st) == 0) {
+                res.file_mb = st.st_size / 1e6;
+                auto start = std::chrono::steady_clock::now();
+                res.ok = run({bcr, "--headless", "--no-cache", "-b", "15", file}, output, usage);
+                std::chrono::duration<double, std::milli> wall = std::chrono::steady_clock::now() - start;
+                res.wall_ms = wall.count();
+                res.rss_mb = usage.ru_maxrss * 1024 / 1e6;
+                res.load_ms = field(output, "load_ms");
+                res.render_ms = field(output, "render_ms");
+                res.frames = static_cast<size_t>(field(output, "frames"));
+            }
+            if (not keep) {
+                std::remove(file.c_str());
+            }
+            size_t records = n_charts * n_bars;
+            std::cout << std::setw(8) << n_charts << std::setw(7) << n_bars << std::setw(11) << records;
+            if (res.ok) {
+                std::cout << std::setw(10) << res.file_mb << std::setw(11) << res.load_ms
+                          << std::setw(11) << res.render_ms << std::setw(11) << res.wall_ms
+                          << std::setw(10) << res.rss_mb << std::setw(12) << res.load_ms * 1e6 / records
+                          << std::setw(10) << res.rss_mb * 1e6 / records << "\n";
+            }
+            else {
+                std::cout << "  FAILED" << (generated ? "" : " (generating)") << "\n";
+            }
+            results.push_back(res);
+        }
+    }
+
+    //* [2] How each measure grows with the size (1.0 is linear).
+    std::cout << "\nGrowth with the number of charts:\n";
+    report_growth(results, "load", &Result::load_ms);
+    report_growth(results, "render", &Result::render_ms);
+    report_growth(results, "RSS", &Result::rss_mb);
+
+    for (const auto &res : results) {
+        if (not res.ok) {
+            return EXIT_FAILURE;
+        }
+    }
+    return EXIT_SUCCESS;
+}